@@ -0,0 +1,102 @@
+// Per-line cost of the record prefix, `[LEVEL] [file:line]`.
+//
+// `legacy` is the prefix as log::stream() used to build it on every line:
+// three std::format calls and a shortened_path() that stat()s the source
+// file and collects its segments into a std::vector.
+// `callsite` is nlog::callsite(), as used by log::stream(ident, file, line),
+// `by address` is nlog::static_callsite(), as used by the formatted API,
+// `static` is NLOG_CALLSITE(), as used by macros.
+
+#include "log/callsite.h++"
+#include "util/level.h++"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace nutsloop;
+
+namespace {
+
+std::string legacy_shortened_path(const std::filesystem::path &path) {
+  using namespace std::filesystem;
+
+  std::ostringstream shortened_path;
+
+  std::filesystem::path abs_path = path.is_absolute() ? path : current_path() / path;
+  if (!exists(abs_path)) {
+    throw filesystem_error("Path does not exist", abs_path, std::error_code());
+  }
+
+  if (abs_path.is_absolute()) {
+    shortened_path << '/';
+  }
+
+  std::vector<std::filesystem::path> segments;
+  for (const auto &segment : abs_path) {
+    if (!segment.empty() && segment != "/") {
+      segments.push_back(segment);
+    }
+  }
+
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const std::string segment_str = segments[i].string();
+    if (i == segments.size() - 2 || i == segments.size() - 1) {
+      shortened_path << segment_str;
+      if (i == segments.size() - 2) {
+        shortened_path << "/";
+      }
+    } else {
+      if (!isalnum(segment_str[0])) {
+        shortened_path << segment_str.substr(0, 2) << "/";
+      } else {
+        shortened_path << segment_str[0] << "/";
+      }
+    }
+  }
+
+  return shortened_path.str();
+}
+
+std::string legacy_prefix(const char *file, const int line, const Level c) {
+  const std::string level_stream = std::format("[{}] ", level(c));
+  const std::string shortened_path_stream =
+      strlen(file) == 0 ? "" : std::format("{}", legacy_shortened_path(file));
+  const std::string line_stream = line == 0 ? "" : std::format("{}", line);
+  const std::string location_stream = std::format("[{}:{}]", shortened_path_stream, line_stream);
+  return level_stream + location_stream;
+}
+
+template <typename F> void measure(const char *name, const int iterations, F &&prefix) {
+
+  std::size_t bytes = 0; // keeps the work observable
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    bytes += prefix();
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+
+  const double ns = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  std::printf("%-10s %10.1f ns/line  (%zu bytes)\n", name, ns, bytes);
+}
+
+} // namespace
+
+int main() {
+
+  constexpr int iterations = 200'000;
+
+  measure("legacy", iterations, [] { return legacy_prefix(__FILE__, __LINE__, INFO).size(); });
+  measure("callsite", iterations,
+          [] { return nlog::callsite(__FILE__, __LINE__, INFO).prefix.size(); });
+  measure("by address", iterations,
+          [] { return nlog::static_callsite(__FILE__, __LINE__, INFO).prefix.size(); });
+  measure("static", iterations, [] { return NLOG_CALLSITE(INFO).prefix.size(); });
+
+  return 0;
+}
@@ -0,0 +1,205 @@
+// Per-call latency and throughput of the logging paths.
+//
+// `stream` is log::stream(ident, NLOG_CALLSITE()), `ostream` is
+// instance::ostream(), `null` is a record below the level of its log, which
+// is discarded without being formatted. Every path is measured with 1 to 64
+// threads writing lines of several sizes, to a synchronous and to an
+// asynchronous log; the counters of the log (log::counters()) are printed
+// along with each run.
+//
+// Build it in both configurations to compare them:
+//   Release: DEBUG_LOG=false, -O3
+//   Debug:   DEBUG_LOG=true, -O0, with the internal debug log
+//
+// Usage: nlog_bench [records per run, 100000 by default]
+
+#include "log.h++"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace nutsloop;
+
+namespace {
+
+#if DEBUG_LOG == true
+constexpr const char *debug_log = "true";
+#else
+constexpr const char *debug_log = "false";
+#endif
+
+constexpr std::array<int, 7> thread_counts{1, 2, 4, 8, 16, 32, 64};
+constexpr std::array<std::size_t, 3> line_sizes{16, 128, 1024};
+
+enum class path_t { STREAM, OSTREAM, NULL_PATH };
+
+struct bench_log_t {
+  const char *ident;
+  handle_t handle;
+  std::unique_ptr<nlog::instance> instance;
+};
+
+bench_log_t make_log(const char *ident, const bool async) {
+
+  log_settings_t settings{ident, std::string{ident} + ".log", true, std::nullopt, std::nullopt};
+  settings.set_sink({.type = nlog::types::sink_type_t::POSIX});
+  if (async) {
+    settings.set_async({.enabled = true, .capacity = 64 * 1024});
+  }
+  // HINT: keeps the files of a run from filling the disk, rotating is part
+  //  of the cost of writing anyway.
+  settings.set_rotation({.max_size = 64 * 1024 * 1024, .generations = 1});
+
+  const handle_t handle = log::set(settings);
+  return {ident, handle, log::get_instance(handle)};
+}
+
+std::chrono::nanoseconds::rep clock_overhead() {
+  constexpr int samples = 100'000;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < samples; ++i) {
+    [[maybe_unused]] const auto now = std::chrono::steady_clock::now();
+  }
+  return (std::chrono::steady_clock::now() - start).count() / samples;
+}
+
+void log_once(const bench_log_t &target, const path_t path, const std::string &line) {
+  switch (path) {
+  case path_t::STREAM:
+    log::stream(target.ident, NLOG_CALLSITE(INFO)) << line << '\n';
+    break;
+  case path_t::OSTREAM:
+    target.instance->ostream() << line << '\n';
+    break;
+  case path_t::NULL_PATH:
+    log::stream(target.ident, NLOG_CALLSITE(DEBUG)) << line << '\n';
+    break;
+  }
+}
+
+std::int64_t percentile(const std::vector<std::int64_t> &sorted, const double p) {
+  return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(p * sorted.size()))];
+}
+
+void run(const char *mode, const bench_log_t &target, const path_t path, const char *name,
+         const int threads, const std::size_t size, const std::size_t records) {
+
+  // HINT: at least one record per thread, the percentiles need a sample.
+  const std::size_t per_thread = std::max<std::size_t>(1, records / threads);
+  const std::string line(size, 'x');
+  std::vector<std::vector<std::int64_t>> latencies(threads);
+  // HINT: each thread times itself, the main thread may be scheduled late.
+  std::vector<std::pair<std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point>>
+      spans(threads);
+  std::barrier start{threads};
+
+  const counters_t before = log::counters(target.handle);
+
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&, t] {
+      std::vector<std::int64_t> &samples = latencies[t];
+      samples.reserve(per_thread);
+      start.arrive_and_wait();
+      spans[t].first = std::chrono::steady_clock::now();
+      for (std::size_t i = 0; i < per_thread; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+        log_once(target, path, line);
+        samples.push_back((std::chrono::steady_clock::now() - begin).count());
+      }
+      spans[t].second = std::chrono::steady_clock::now();
+    });
+  }
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  // the records are written, and synced, once the queue of an asynchronous
+  // log has been drained.
+  log::flush(target.ident);
+  const auto flushed = std::chrono::steady_clock::now();
+
+  auto begin = spans.front().first;
+  auto end = spans.front().second;
+  for (const auto &[first, last] : spans) {
+    begin = std::min(begin, first);
+    end = std::max(end, last);
+  }
+  const std::chrono::duration<double> calling = end - begin;
+  const std::chrono::duration<double> writing = flushed - begin;
+
+  const counters_t after = log::counters(target.handle);
+
+  std::vector<std::int64_t> all;
+  all.reserve(per_thread * threads);
+  for (const std::vector<std::int64_t> &samples : latencies) {
+    all.insert(all.end(), samples.begin(), samples.end());
+  }
+  std::sort(all.begin(), all.end());
+
+  const double total = static_cast<double>(per_thread * threads);
+  std::printf("%-5s %-7s %3d %5zu | %11.0f %9.1f | %7lld %7lld %7lld %8lld %9lld | %8llu %9.1f "
+              "%6llu\n",
+              mode, name, threads, size, total / calling.count(),
+              static_cast<double>(after.bytes - before.bytes) / writing.count() / (1024 * 1024),
+              static_cast<long long>(percentile(all, 0.50)),
+              static_cast<long long>(percentile(all, 0.90)),
+              static_cast<long long>(percentile(all, 0.99)),
+              static_cast<long long>(percentile(all, 0.999)), static_cast<long long>(all.back()),
+              static_cast<unsigned long long>(after.flushes - before.flushes),
+              std::chrono::duration<double, std::milli>(after.write_time - before.write_time)
+                  .count(),
+              static_cast<unsigned long long>(after.queue_high_water));
+}
+
+} // namespace
+
+int main(const int argc, char **argv) {
+
+  const std::size_t records = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+
+  std::printf("DEBUG_LOG=%s NLOG_MIN_LEVEL=%d, %zu records per run, clock overhead %lld ns "
+              "(included in the latencies)\n\n",
+              debug_log, NLOG_MIN_LEVEL, records,
+              static_cast<long long>(clock_overhead()));
+
+  const bench_log_t sync_log = make_log("nlog_bench_sync", false);
+  const bench_log_t async_log = make_log("nlog_bench_async", true);
+  log::activate();
+
+  std::printf("%-5s %-7s %3s %5s | %11s %9s | %7s %7s %7s %8s %9s | %8s %9s %6s\n", "mode", "path",
+              "thr", "size", "calls/s", "MiB/s", "p50", "p90", "p99", "p99.9", "max",
+              "flushes", "write ms", "queue");
+
+  for (const auto &[mode, target] :
+       {std::pair{"sync", &sync_log}, std::pair{"async", &async_log}}) {
+    for (const auto &[path, name] : {std::pair{path_t::STREAM, "stream"},
+                                     std::pair{path_t::OSTREAM, "ostream"},
+                                     std::pair{path_t::NULL_PATH, "null"}}) {
+      for (const int threads : thread_counts) {
+        for (const std::size_t size : line_sizes) {
+          run(mode, *target, path, name, threads, size, records);
+        }
+      }
+    }
+  }
+
+  std::printf("\ncalls/s until the logging threads return, MiB/s until the records are synced.\n"
+              "latencies in ns, queue is the high-water mark of the asynchronous queue so far.\n");
+
+  log::close(sync_log.ident);
+  log::close(async_log.ident);
+  return 0;
+}
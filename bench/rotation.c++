@@ -0,0 +1,266 @@
+// Rotation check.
+//
+// Logs rotated by size, synchronous and asynchronous, write past their
+// `max_size` many times; once nlog::rotation::wait() returns, `<file>.1` up to
+// `<file>.<generations>` must exist, the generation past them must be gone,
+// every file must start with a session header and the records kept must be
+// the last ones logged, in order. A log rotated by time must rotate on the
+// first record written once its interval is over, and the rotated files of a
+// compressed log must carry the magic number of their codec (or be left
+// uncompressed when the library has been built without it). The exit status
+// is 1 if any check failed.
+//
+// Usage: nlog_rotation
+
+#include "log.h++"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace nutsloop;
+
+namespace {
+
+namespace fs = std::filesystem;
+
+fs::path generation(const fs::path &path, const std::size_t number, const char *extension = "") {
+  fs::path rotated = path;
+  rotated += std::format(".{}{}", number, extension);
+  return rotated;
+}
+
+/**
+ * Removes the file of a log and every generation a previous run left behind.
+ */
+void clean(const fs::path &path) {
+  std::error_code error;
+  fs::remove(path, error);
+  for (std::size_t number = 1; number <= 16; ++number) {
+    for (const char *extension : {"", ".gz", ".zst"}) {
+      fs::remove(generation(path, number, extension), error);
+    }
+  }
+}
+
+handle_t set_rotated(const std::string &ident, const rotation_settings_t &rotation,
+                     const bool async) {
+  log_settings_t settings{ident, ident + ".log", true, std::nullopt, std::nullopt};
+  settings.set_rotation(rotation);
+  settings.set_async({.enabled = async});
+  clean(settings.absolute_path());
+  const handle_t handle = log::set(settings);
+  log::activate();
+  return handle;
+}
+
+// HINT: the line of a record is `<prefix> #<sequence> <padding>`.
+void log_line(const handle_t handle, const int sequence) {
+  log::info(handle, "#{} {}", sequence, std::string(64, 'r'));
+}
+
+/**
+ * Reads a file, returns whether it starts with the session header of `ident`
+ * and appends the sequence numbers of its records to `sequences`.
+ */
+bool read_log(const fs::path &path, const std::string &ident, std::vector<int> &sequences) {
+
+  std::ifstream file{path};
+  std::string line;
+  // HINT: the header is `\n<header>\n\n`, it names the log.
+  if (!std::getline(file, line) || !line.empty() || !std::getline(file, line) ||
+      line.find(std::format("[{}]", ident)) == std::string::npos) {
+    return false;
+  }
+  while (std::getline(file, line)) {
+    if (const std::size_t mark = line.find('#'); mark != std::string::npos) {
+      sequences.push_back(std::stoi(line.substr(mark + 1)));
+    }
+  }
+  return true;
+}
+
+/**
+ * Rotates a log by size several times past its generations, returns the
+ * number of problems found.
+ */
+int check_size(const bool async) {
+
+  const std::string ident = std::format("nlog_rotation_size_{}", async ? "async" : "sync");
+  constexpr std::size_t generations = 3;
+  constexpr int lines = 400;
+  const handle_t handle =
+      set_rotated(ident, {.max_size = 4096, .generations = generations}, async);
+  const fs::path path = log::get_absolute_path(ident);
+
+  for (int sequence = 0; sequence < lines; ++sequence) {
+    log_line(handle, sequence);
+    // HINT: an asynchronous log counts its bytes by batch, draining the
+    //  queue keeps the batches, and the rotated files, small.
+    if (sequence % 20 == 19) {
+      log::flush(ident);
+    }
+  }
+  log::close(ident);
+  nlog::rotation::wait();
+
+  int problems = 0;
+  // the oldest generation first, the records must follow each other up to
+  // the last one logged.
+  std::vector<int> sequences;
+  for (std::size_t number = generations; number >= 1; --number) {
+    const fs::path rotated = generation(path, number);
+    if (!fs::exists(rotated)) {
+      std::printf("    %s is missing\n", rotated.c_str());
+      ++problems;
+      continue;
+    }
+    if (fs::file_size(rotated) < 4096) {
+      std::printf("    %s holds %ju bytes, rotated before max_size\n", rotated.c_str(),
+                  static_cast<std::uintmax_t>(fs::file_size(rotated)));
+      ++problems;
+    }
+    if (!read_log(rotated, ident, sequences)) {
+      std::printf("    %s does not start with the session header\n", rotated.c_str());
+      ++problems;
+    }
+  }
+  if (!read_log(path, ident, sequences)) {
+    std::printf("    %s does not start with the session header\n", path.c_str());
+    ++problems;
+  }
+  if (fs::exists(generation(path, generations + 1))) {
+    std::printf("    %s is past the generations kept\n",
+                generation(path, generations + 1).c_str());
+    ++problems;
+  }
+
+  if (sequences.empty() || sequences.back() != lines - 1) {
+    std::printf("    the last record is missing\n");
+    ++problems;
+  }
+  for (std::size_t i = 1; i < sequences.size(); ++i) {
+    if (sequences[i] != sequences[i - 1] + 1) {
+      std::printf("    record #%d follows #%d\n", sequences[i], sequences[i - 1]);
+      ++problems;
+      break;
+    }
+  }
+  // HINT: 400 records of about 100 bytes rotate well past 3 generations.
+  if (!sequences.empty() && sequences.front() == 0) {
+    std::printf("    the first record has been kept, the oldest generation was not removed\n");
+    ++problems;
+  }
+
+  return problems;
+}
+
+/**
+ * Rotates a log by time once, returns the number of problems found.
+ */
+int check_interval() {
+
+  const std::string ident = "nlog_rotation_interval";
+  const handle_t handle =
+      set_rotated(ident, {.interval = std::chrono::seconds(1), .generations = 2}, false);
+  const fs::path path = log::get_absolute_path(ident);
+
+  int problems = 0;
+  log_line(handle, 0);
+  if (fs::exists(generation(path, 1))) {
+    std::printf("    rotated before the interval is over\n");
+    ++problems;
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  // HINT: the interval is checked when writing, this record closes the file.
+  log_line(handle, 1);
+  log::close(ident);
+  nlog::rotation::wait();
+
+  std::vector<int> rotated;
+  if (!read_log(generation(path, 1), ident, rotated) || rotated != std::vector<int>{0, 1}) {
+    std::printf("    %s does not hold the header and records #0 #1\n",
+                generation(path, 1).c_str());
+    ++problems;
+  }
+  std::vector<int> current;
+  if (!read_log(path, ident, current) || !current.empty()) {
+    std::printf("    %s does not hold the session header alone\n", path.c_str());
+    ++problems;
+  }
+  return problems;
+}
+
+/**
+ * Rotates a compressed log, returns the number of problems found.
+ */
+int check_compression(const compression_t compression, const char *name, const char *extension,
+                      const std::string_view magic) {
+
+  const std::string ident = std::format("nlog_rotation_{}", name);
+  const handle_t handle =
+      set_rotated(ident, {.max_size = 4096, .generations = 2, .compression = compression}, false);
+  const fs::path path = log::get_absolute_path(ident);
+
+  // HINT: about 15 KiB, rotated 3 times, past the 2 generations kept.
+  for (int sequence = 0; sequence < 150; ++sequence) {
+    log_line(handle, sequence);
+  }
+  log::close(ident);
+  nlog::rotation::wait();
+
+  // HINT: without the codec the rotated files are kept as they are.
+  std::vector<int> sequences;
+  if (fs::exists(generation(path, 1)) && !fs::exists(generation(path, 1, extension))) {
+    std::printf("    %s not built in, rotated files left uncompressed\n", name);
+    return read_log(generation(path, 1), ident, sequences) ? 0 : 1;
+  }
+
+  int problems = 0;
+  for (std::size_t number = 1; number <= 2; ++number) {
+    const fs::path rotated = generation(path, number, extension);
+    std::ifstream file{rotated, std::ios::binary};
+    std::string head(magic.size(), '\0');
+    if (!file.read(head.data(), static_cast<std::streamsize>(head.size())) || head != magic) {
+      std::printf("    %s is missing or not %s\n", rotated.c_str(), name);
+      ++problems;
+    }
+    if (fs::exists(generation(path, number))) {
+      std::printf("    %s has been left next to its compressed copy\n",
+                  generation(path, number).c_str());
+      ++problems;
+    }
+  }
+  return problems;
+}
+
+} // namespace
+
+int main() {
+
+  int failed = 0;
+  const auto report = [&failed](const char *name, const int problems) {
+    std::printf("%-12s %s\n", name, problems == 0 ? "ok" : "FAILED");
+    if (problems > 0) {
+      ++failed;
+    }
+  };
+
+  report("size sync", check_size(false));
+  report("size async", check_size(true));
+  report("interval", check_interval());
+  report("gzip", check_compression(compression_t::GZIP, "gzip", ".gz", "\x1f\x8b"));
+  report("zstd", check_compression(compression_t::ZSTD, "zstd", ".zst", "\x28\xb5\x2f\xfd"));
+
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+// Binary encode/decode round trip.
+//
+// Every sink writes a binary log whose records end with zero bytes (an
+// integer 0, `false`, an empty string), the log is closed, opened again under
+// another ident and written to again. nlog-decode must then print every
+// record of both runs, in order. The exit status is 1 if any check failed.
+//
+// Usage: nlog_roundtrip NLOG_DECODE
+
+#include "log.h++"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+using namespace nutsloop;
+
+namespace {
+
+// HINT: the messages as nlog-decode prints them, after the prefix.
+const std::vector<std::string> expected{
+    "streamed 0",   "first run 7 0", "flag false", "empty []",
+    "second run 0", "flag true",     "empty []",
+};
+
+void write_run(const std::string &ident, const std::string &filename,
+               const nlog::types::sink_type_t sink, const bool first) {
+
+  log_settings_t settings{ident, filename, true, std::nullopt, std::nullopt};
+  settings.set_sink({.type = sink});
+  settings.set_encoding(encoding_t::BINARY);
+  const handle_t handle = log::set(settings);
+  log::activate();
+
+  if (first) {
+    log::stream(handle, NLOG_CALLSITE(INFO)) << "streamed " << 0 << '\n';
+    log::info(handle, "first run {} {}", 7, 0);
+    log::info(handle, "flag {}", false);
+    log::info(handle, "empty [{}]", "");
+  } else {
+    log::info(handle, "second run {}", 0);
+    log::info(handle, "flag {}", true);
+    log::info(handle, "empty [{}]", "");
+  }
+  log::close(ident);
+}
+
+/**
+ * Decodes the file with nlog-decode, returns the number of problems found.
+ */
+int verify(const char *decoder, const std::filesystem::path &path) {
+
+  const std::string command = std::format("'{}' '{}'", decoder, path.string());
+  FILE *output = ::popen(command.c_str(), "r");
+  if (output == nullptr) {
+    std::printf("    cannot run %s\n", command.c_str());
+    return 1;
+  }
+
+  std::vector<std::string> messages;
+  std::string line;
+  for (int c = std::fgetc(output); c != EOF; c = std::fgetc(output)) {
+    if (c != '\n') {
+      line.push_back(static_cast<char>(c));
+      continue;
+    }
+    // HINT: `time [thread] [LEVEL] [file:line] message`
+    std::size_t message = 0;
+    for (int field = 0; field < 3 && message != std::string::npos; ++field) {
+      message = line.find("] ", message);
+      message = message == std::string::npos ? message : message + 2;
+    }
+    messages.push_back(message == std::string::npos ? line : line.substr(message));
+    line.clear();
+  }
+  const int status = ::pclose(output);
+
+  int problems = status == 0 ? 0 : 1;
+  if (messages.size() != expected.size()) {
+    std::printf("    %zu records decoded, %zu expected\n", messages.size(), expected.size());
+    ++problems;
+  }
+  for (std::size_t i = 0; i < std::min(messages.size(), expected.size()); ++i) {
+    if (messages[i] != expected[i]) {
+      std::printf("    record %zu: [%s], expected [%s]\n", i, messages[i].c_str(),
+                  expected[i].c_str());
+      ++problems;
+    }
+  }
+  return problems;
+}
+
+} // namespace
+
+int main(const int argc, char **argv) {
+
+  if (argc < 2) {
+    std::fprintf(stderr, "usage: nlog_roundtrip NLOG_DECODE\n");
+    return 2;
+  }
+
+  int failed = 0;
+
+  for (const auto &[sink, sink_name] : {std::pair{nlog::types::sink_type_t::OSTREAM, "ostream"},
+                                        std::pair{nlog::types::sink_type_t::POSIX, "posix"},
+                                        std::pair{nlog::types::sink_type_t::IO_URING, "io_uring"},
+                                        std::pair{nlog::types::sink_type_t::MMAP, "mmap"}}) {
+
+    const std::string filename = std::format("nlog_roundtrip_{}.log", sink_name);
+    log_settings_t settings{filename, filename, true, std::nullopt, std::nullopt};
+    const std::filesystem::path path = settings.absolute_path();
+    std::error_code error;
+    std::filesystem::remove(path, error);
+
+    // HINT: an ident is registered for good, reopening takes another one.
+    write_run(std::format("nlog_roundtrip_{}_1", sink_name), filename, sink, true);
+    write_run(std::format("nlog_roundtrip_{}_2", sink_name), filename, sink, false);
+
+    std::printf("%-8s %llu bytes\n", sink_name,
+                static_cast<unsigned long long>(std::filesystem::file_size(path, error)));
+    if (const int problems = verify(argv[1], path); problems > 0) {
+      std::printf("    FAILED, %d problems\n", problems);
+      ++failed;
+    }
+  }
+
+  return failed == 0 ? 0 : 1;
+}
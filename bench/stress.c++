@@ -0,0 +1,182 @@
+// Torn-line and ordering stress test.
+//
+// Many threads log numbered lines, built from several insertions or from a
+// format string, to every sink, synchronous and asynchronous. Once the log is
+// closed its file is read back: every line must be whole (its checksum
+// matches), and the lines of each thread must all be there, in the order they
+// were logged. The counters of the log, read after closing it, must account
+// for every line, none dropped since the queue of an asynchronous log blocks
+// when full. The exit status is 1 if any check failed.
+//
+// Usage: nlog_stress [threads, 16 by default] [lines per thread, 20000 by default]
+
+#include "log.h++"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+using namespace nutsloop;
+
+namespace {
+
+// HINT: a line is `<prefix> #<thread> <sequence> <payload> <checksum>`, the
+//  payload length varies so that lines straddle buffer boundaries.
+std::string payload(const int thread, const int sequence) {
+  const std::size_t size = 1 + (static_cast<std::size_t>(thread) * 131 + sequence * 17) % 700;
+  return std::string(size, static_cast<char>('a' + (thread + sequence) % 26));
+}
+
+std::uint32_t checksum(const int thread, const int sequence, const std::string_view text) {
+  std::uint32_t sum = 2166136261U;
+  for (const char c : text) {
+    sum = (sum ^ static_cast<unsigned char>(c)) * 16777619U;
+  }
+  return sum ^ static_cast<std::uint32_t>(thread * 1'000'003 + sequence);
+}
+
+void log_lines(const handle_t handle, const int thread, const int lines) {
+  for (int sequence = 0; sequence < lines; ++sequence) {
+    const std::string text = payload(thread, sequence);
+    const std::uint32_t sum = checksum(thread, sequence, text);
+    if (sequence % 2 == 0) {
+      log::stream(handle, NLOG_CALLSITE(INFO))
+          << '#' << thread << ' ' << sequence << ' ' << text << ' ' << sum << '\n';
+    } else {
+      log::info(handle, "#{} {} {} {}", thread, sequence, text, sum);
+    }
+  }
+}
+
+/**
+ * Reads the file back, returns the number of problems found.
+ */
+int verify(const std::filesystem::path &path, const int threads, const int lines) {
+
+  std::ifstream file{path};
+  std::vector<int> next(threads, 0);
+  int problems = 0;
+  const auto report = [&](const char *what, const std::string &line) {
+    if (++problems <= 5) {
+      std::printf("    %s: %.120s\n", what, line.c_str());
+    }
+  };
+
+  std::string line;
+  while (std::getline(file, line)) {
+    const std::size_t mark = line.find('#');
+    if (mark == std::string::npos) {
+      continue; // the session header.
+    }
+    int thread = -1;
+    int sequence = -1;
+    unsigned long sum = 0;
+    char text[1024];
+    if (std::sscanf(line.c_str() + mark, "#%d %d %1023s %lu", &thread, &sequence, text, &sum) !=
+            4 ||
+        thread < 0 || thread >= threads) {
+      report("torn line", line);
+      continue;
+    }
+    if (sum != checksum(thread, sequence, text) || payload(thread, sequence) != text) {
+      report("corrupted line", line);
+      continue;
+    }
+    if (sequence != next[thread]) {
+      report("out of order or missing", line);
+    }
+    next[thread] = sequence + 1;
+  }
+
+  for (int thread = 0; thread < threads; ++thread) {
+    if (next[thread] != lines) {
+      std::printf("    thread %d: last line %d of %d\n", thread, next[thread] - 1, lines);
+      ++problems;
+    }
+  }
+  return problems;
+}
+
+} // namespace
+
+int main(const int argc, char **argv) {
+
+  const int threads = argc > 1 ? std::atoi(argv[1]) : 16;
+  const int lines = argc > 2 ? std::atoi(argv[2]) : 20'000;
+
+  int failed = 0;
+
+  for (const auto &[sink, sink_name] : {std::pair{nlog::types::sink_type_t::OSTREAM, "ostream"},
+                                        std::pair{nlog::types::sink_type_t::POSIX, "posix"},
+                                        std::pair{nlog::types::sink_type_t::IO_URING, "io_uring"},
+                                        std::pair{nlog::types::sink_type_t::MMAP, "mmap"}}) {
+    for (const bool async : {false, true}) {
+
+      const std::string ident =
+          std::format("nlog_stress_{}_{}", sink_name, async ? "async" : "sync");
+      log_settings_t settings{ident, ident + ".log", true, std::nullopt, std::nullopt};
+      // HINT: small buffers and a small queue, so that they fill up often.
+      settings.set_sink({.type = sink, .buffer_size = 4096, .segment_size = 64 * 1024});
+      if (async) {
+        settings.set_async({.enabled = true,
+                            .capacity = 256,
+                            .overflow = nlog::types::overflow_policy_t::BLOCK});
+      }
+      const std::filesystem::path path = settings.absolute_path();
+      std::error_code error;
+      std::filesystem::remove(path, error);
+
+      const handle_t handle = log::set(settings);
+      log::activate();
+
+      std::vector<std::thread> workers;
+      for (int thread = 0; thread < threads; ++thread) {
+        workers.emplace_back(log_lines, handle, thread, lines);
+      }
+      for (std::thread &worker : workers) {
+        worker.join();
+      }
+      // HINT: closing writes whatever an asynchronous log still holds.
+      log::close(ident);
+      const counters_t counters = log::counters(handle);
+
+      std::printf("%-8s %-5s %llu records %llu bytes %llu flushes %llu dropped %llu queued\n",
+                  sink_name, async ? "async" : "sync",
+                  static_cast<unsigned long long>(counters.records),
+                  static_cast<unsigned long long>(counters.bytes),
+                  static_cast<unsigned long long>(counters.flushes),
+                  static_cast<unsigned long long>(counters.dropped),
+                  static_cast<unsigned long long>(counters.queue_high_water));
+      int problems = verify(path, threads, lines);
+      if (counters.records != static_cast<std::uint64_t>(threads) * lines) {
+        std::printf("    the counters report %llu records\n",
+                    static_cast<unsigned long long>(counters.records));
+        ++problems;
+      }
+      // HINT: the overflow policy is BLOCK, no record may be lost.
+      if (counters.dropped != 0) {
+        std::printf("    the counters report %llu dropped records\n",
+                    static_cast<unsigned long long>(counters.dropped));
+        ++problems;
+      }
+      if (async && counters.queue_high_water == 0) {
+        std::printf("    the counters report an empty queue\n");
+        ++problems;
+      }
+      if (problems > 0) {
+        std::printf("    FAILED, %d problems\n", problems);
+        ++failed;
+      }
+    }
+  }
+
+  return failed == 0 ? 0 : 1;
+}
@@ -6,23 +6,27 @@
 #include "util/level.h++"
 #endif
 
+#include "log/async_writer.h++"
+#include "log/callsite.h++"
+#include "log/format.h++"
+#include "log/record.h++"
+#include "log/rotation.h++"
+#include "log/sink.h++"
+#include "util/fixed_string.h++"
+
+#include <array>
 #include <atomic>
+#include <cstdint>
 #include <shared_mutex>
 
-// MARK: (LOG) experimental instance class pre-processor
-#ifndef EXPERIMENTAL_INSTANCE
-// HINT: default value if not defined elsewhere
-#define EXPERIMENTAL_INSTANCE false
-#endif
-
-#if EXPERIMENTAL_INSTANCE == true
-
-#warning "EXPERIMENTAL_INSTANCE is enabled"
-
-#include "log/instance.h++"
-#endif
-
 constexpr size_t LOG_MAX_SIZE = 10 * 1024 * 1024;
+// HINT: capacity of the handle table, how many logs can be set.
+constexpr size_t LOG_MAX_HANDLES = 64;
+
+namespace nutsloop::nlog {
+// HINT: log/instance.h++ is included at the bottom, it needs `log` complete.
+class instance;
+} // namespace nutsloop::nlog
 
 namespace nutsloop {
 
@@ -59,7 +63,8 @@ public:
    * that no further log entries can be recorded until reactivation. If the
    * system was previously active, the change is logged in the internal debug
    * stream, provided debugging is enabled. Thread-safe mechanisms are employed
-   * to ensure safe updates to the active status.
+   * to ensure safe updates to the active status. Records already queued by
+   * asynchronous logs are written before the method returns.
    *
    * @note This method is primarily used when logging functionality is no longer
    * needed or before shutting down the application. Any logs generated after
@@ -80,8 +85,11 @@ public:
    *
    * @param settings The configuration object containing logging parameters
    * to be applied to the logging system.
+   * @return The handle of the log, stable for the whole program. Setting an
+   * identifier again returns the handle it already has.
+   * @throws std::length_error if `LOG_MAX_HANDLES` logs have already been set.
    */
-  static void set(log_settings_t &settings);
+  static handle_t set(log_settings_t &settings);
   /**
    * Initiates the logging process for the specified log identifier.
    *
@@ -121,11 +129,11 @@ public:
   static bool is_open(const std::string &ident);
   static void close(const std::string &ident);
   /**
-   * Flushes and resets the specified log output stream based on its identifier.
+   * Makes every record of the specified log durable.
    *
-   * This method ensures that the log associated with the provided identifier is
-   * properly flushed and reopened with clean content. The internal logging
-   * structure is thread-safe with appropriate locks during the operation.
+   * Records still queued by an asynchronous log are written first, then the
+   * sink hands whatever it buffers to the kernel and waits for the file to
+   * reach the disk (`fsync`). The file is neither truncated nor reopened.
    *
    * If the log identifier does not exist in the registry, the method logs an
    * error in debug mode and terminates without further action.
@@ -137,10 +145,33 @@ public:
 
   static std::filesystem::path get_absolute_path(const std::string &ident);
 
-#if EXPERIMENTAL_INSTANCE == true
-  // MARK: (LOG) experimental instance methods and fields
+  /**
+   * Returns how many records an asynchronous log discarded because of its
+   * overflow policy (`DROP_NEWEST`, `DROP_OLDEST`) or because they were
+   * written after the log was closed.
+   *
+   * @param ident The unique identifier of the log.
+   * @return The number of dropped records, always 0 for synchronous logs.
+   * @throws std::invalid_argument if the identifier is not found.
+   */
+  static std::uint64_t dropped(const std::string &ident);
+
+  /**
+   * Returns a snapshot of what a log has written so far: records, bytes,
+   * flushes, time spent in write system calls, dropped records and the
+   * high-water mark of the queue of an asynchronous log.
+   *
+   * The counters are always kept, taking a snapshot costs a few relaxed
+   * loads and can be done from any thread, before or after `log::close()`.
+   *
+   * @throws std::invalid_argument if the log is unknown.
+   */
+  static counters_t counters(handle_t handle);
+  static counters_t counters(const std::string &ident);
+
+  // MARK: (LOG) instance methods and fields
   static std::unique_ptr<nlog::instance> get_instance(const std::string &ident);
-#endif
+  static std::unique_ptr<nlog::instance> get_instance(handle_t handle);
 
   // HINT: not completely implemented yet.
   static bool full_running(const std::string &ident);
@@ -150,30 +181,164 @@ public:
   static void unset(std::string ident) = delete;
 
   /**
-   * Provides an output stream to log messages for a specified identifier with
+   * Provides a record to log messages for a specified identifier with
    * metadata.
    *
-   * This method retrieves a logging stream associated with the given
-   * identifier. The metadata such as file name, line number, and log level are
-   * also added as a log entry prefix. It performs multiple checks to ensure the
-   * log is active, running, and properly configured. If any of these checks
-   * fail, a null stream is returned. Otherwise, a valid stream for the
-   * specified identifier is provided for logging.
+   * This method creates a `nlog::record` bound to the log associated with the
+   * given identifier. The metadata such as file name, line number, and log
+   * level are added as a log entry prefix. It performs multiple checks to
+   * ensure the log is active, running, and properly configured. If any of
+   * these checks fail, a null record, discarding everything, is returned.
    *
-   * Thread-safe locking mechanisms are used to ensure consistent log behavior
-   * during concurrent operations. Logs debugging details when debug mode is
-   * enabled.
+   * The record is formatted in its own buffer and committed to the file with a
+   * single write when the temporary is destroyed, at the end of the
+   * expression, so concurrent records never interleave. Logs debugging details
+   * when debug mode is enabled.
+   *
+   * The prefix of a call site is computed on its first use only, see
+   * `nlog::callsite()`.
    *
    * @param ident The unique identifier of the log to use.
-   * @param file The name of the source file where the log is recorded.
+   * @param file The name of the source file where the log is recorded,
+   * usually `__FILE__`; any string will do, the call site keeps a copy. A
+   * relative name is shortened as given, it is not made absolute.
    * @param line The line number in the source file where the log is recorded.
    * @param c The log level (e.g., INFO, DEBUG, ERROR, NONE) for the log entry.
    *              Defaults to INFO if not specified.
-   * @return A reference to the logging output stream if successful, or a null
-   * stream if conditions do not permit logging.
+   * @return A record bound to the log if successful, or a null record if
+   * conditions do not permit logging.
+   */
+  static nlog::record stream(const char *ident, const char *file, int line, Level c = INFO);
+  /**
+   * Same as above, for a call site descriptor already resolved, e.g. by
+   * `NLOG_CALLSITE(level)`, which makes the prefix free of any lookup.
+   *
+   * ```c++
+   * log::stream("log", NLOG_CALLSITE(WARN)) << "disk almost full" << '\n';
+   * ```
    */
-  static std::ostream &stream(const char *ident, const char *file, int line, Level c = INFO);
-  static std::ostream &stream(const char *ident);
+  static nlog::record stream(const char *ident, const nlog::callsite_t &site);
+  static nlog::record stream(const char *ident);
+
+  /**
+   * Logs one line, formatted with `std::format` syntax, to the log
+   * identified by `ident`.
+   *
+   * The format string is checked against the arguments at compile time and
+   * the source location of the call is recorded automatically. The log is
+   * looked up once per identifier, not on every call.
+   *
+   * For asynchronous logs whose arguments are all arithmetic values or
+   * strings, the calling thread only copies the raw arguments into the queue
+   * and the line is formatted by the writer thread. Otherwise it is formatted
+   * on the calling thread and committed as a single record.
+   *
+   * ```c++
+   * log::info<"log">("user {} took {}ms", id, ms);
+   * ```
+   *
+   * @tparam ident The unique identifier of the log to use.
+   * @param format The format string, a literal.
+   * @param args The values to format, a trailing newline is added.
+   */
+  template <fixed_string ident, typename... Args>
+  static void trace(nlog::format_t<Args...> format, Args &&...args) {
+    write_<ident>(TRACE, format, std::forward<Args>(args)...);
+  }
+  template <fixed_string ident, typename... Args>
+  static void debug(nlog::format_t<Args...> format, Args &&...args) {
+    write_<ident>(DEBUG, format, std::forward<Args>(args)...);
+  }
+  template <fixed_string ident, typename... Args>
+  static void info(nlog::format_t<Args...> format, Args &&...args) {
+    write_<ident>(INFO, format, std::forward<Args>(args)...);
+  }
+  template <fixed_string ident, typename... Args>
+  static void warn(nlog::format_t<Args...> format, Args &&...args) {
+    write_<ident>(WARN, format, std::forward<Args>(args)...);
+  }
+  template <fixed_string ident, typename... Args>
+  static void error(nlog::format_t<Args...> format, Args &&...args) {
+    write_<ident>(ERROR, format, std::forward<Args>(args)...);
+  }
+
+  // MARK: (LOG) handle based methods, the hot path
+
+  /**
+   * Provides a record for the log behind `handle`.
+   *
+   * Resolving the handle is an array access and the checks on the log state
+   * are two atomic loads: no hashing, no string and no lock are involved.
+   *
+   * ```c++
+   * const handle_t handle = log::set(settings);
+   * log::stream(handle, NLOG_CALLSITE(INFO)) << "ready" << '\n';
+   * ```
+   *
+   * @param handle The handle returned by `log::set()`.
+   * @param site The call site descriptor, see `NLOG_CALLSITE(level)`.
+   * @return A record bound to the log if it is writable, or a null record.
+   */
+  static nlog::record stream(handle_t handle, const nlog::callsite_t &site);
+  static nlog::record stream(handle_t handle);
+
+  /**
+   * Same as `log::info<"ident">()`, through a handle.
+   */
+  template <typename... Args>
+  static void trace(const handle_t handle, nlog::format_t<Args...> format, Args &&...args) {
+    write_(handle, TRACE, format, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  static void debug(const handle_t handle, nlog::format_t<Args...> format, Args &&...args) {
+    write_(handle, DEBUG, format, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  static void info(const handle_t handle, nlog::format_t<Args...> format, Args &&...args) {
+    write_(handle, INFO, format, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  static void warn(const handle_t handle, nlog::format_t<Args...> format, Args &&...args) {
+    write_(handle, WARN, format, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  static void error(const handle_t handle, nlog::format_t<Args...> format, Args &&...args) {
+    write_(handle, ERROR, format, std::forward<Args>(args)...);
+  }
+
+  // MARK: (LOG) level filtering
+
+  /**
+   * Sets the minimum level of a log, records below it are discarded.
+   *
+   * The level can be changed at any time, from any thread. The initial one
+   * is `log_settings_t::get_level()`. Records logged with `NONE` carry no
+   * level and are never discarded.
+   *
+   * @throws std::invalid_argument if the log is unknown.
+   */
+  static void set_level(handle_t handle, Level c);
+  static void set_level(const std::string &ident, Level c);
+  static Level get_level(handle_t handle);
+
+  /**
+   * Whether a record of level `c` logged through `handle` would be kept.
+   *
+   * Levels below `NLOG_MIN_LEVEL` are rejected at compile time, the others
+   * cost one relaxed load and a comparison. The `NLOG_<LEVEL>()` macros check
+   * it before evaluating any argument.
+   */
+  static bool enabled(const handle_t handle, const Level c) {
+    return c >= min_level && handle.index < LOG_MAX_HANDLES &&
+           c >= levels_[handle.index].load(std::memory_order_relaxed);
+  }
+  template <fixed_string ident> static bool enabled(const Level c) {
+    if (c < min_level) {
+      return false;
+    }
+    const log_t *log_ident = find_<ident>();
+    return log_ident != nullptr && level_enabled_(log_ident, c);
+  }
 
   /**
    * Activates the stream redirection within the logging system.
@@ -193,6 +358,9 @@ public:
   static void deactivate_stream_redirect();
 
 private:
+  // HINT: starts the file it opens after rotating with a session header.
+  friend class nlog::rotation;
+
 #if DEBUG_LOG == true
   // MARK: (LOG) private static log debug info file methods and fields
   static std::unique_ptr<nlog::internal_debug> internal_debug_;
@@ -247,11 +415,18 @@ private:
   static std::optional<std::string> error_on_log_file_(const log_t *log_ident);
 
   static void set_log_registry_();
+  /**
+   * Stops the writer thread of every asynchronous log, writing whatever is
+   * still queued.
+   *
+   * Registered with `std::atexit()` when the registry is created, it runs
+   * before the function-local statics the writers depend on are destroyed.
+   */
+  static void shutdown_();
   static bool registry_has_item_(std::string ident);
   static std::unique_ptr<log_registry_t> log_registry_;
 
   static log_t *set_log_(log_settings_t *settings);
-  static std::unique_ptr<log_t> log_;
 
   /**
    * Creates a directory at the specified path using default settings.
@@ -266,6 +441,77 @@ private:
 
   static std::optional<log_t *> null_stream_(const std::string &ident);
 
+  /**
+   * Looks a log up by identifier, without the diagnostics of null_stream_().
+   *
+   * @return The log, or nullptr if it has not been set yet.
+   */
+  static log_t *find_(std::string_view ident);
+  /**
+   * Caches the result of find_() for a compile-time identifier, the registry
+   * is only searched until the log is found.
+   */
+  template <fixed_string ident> static log_t *find_() {
+    static std::atomic<log_t *> cached{nullptr};
+    log_t *log_ident = cached.load(std::memory_order_acquire);
+    if (log_ident == nullptr) {
+      log_ident = find_(ident.view());
+      cached.store(log_ident, std::memory_order_release);
+    }
+    return log_ident;
+  }
+  /**
+   * Whether the system is activated and the log active, running and open.
+   */
+  static bool writable_(const log_t *log_ident) {
+    return activated_.load(std::memory_order_relaxed) && log_ident->is_writable();
+  }
+
+  /**
+   * The handle table, slots are filled by set_log_() and never emptied, so a
+   * handle stays valid for the whole program.
+   */
+  static std::array<std::atomic<log_t *>, LOG_MAX_HANDLES> handles_;
+  static std::atomic<std::uint32_t> handles_size_;
+  // HINT: the minimum level of each log, by handle, next to each other so
+  //  that a disabled check touches a single cache line.
+  static std::array<std::atomic<Level>, LOG_MAX_HANDLES> levels_;
+  static bool level_enabled_(const log_t *log_ident, const Level c) {
+    return c >= min_level && c >= levels_[log_ident->handle].load(std::memory_order_relaxed);
+  }
+  /**
+   * @return The log behind `handle`, or nullptr for an unknown handle.
+   */
+  static log_t *resolve_(const handle_t handle) {
+    return handle.index < LOG_MAX_HANDLES ? handles_[handle.index].load(std::memory_order_acquire)
+                                          : nullptr;
+  }
+
+  template <typename... Args>
+  static void write_(const handle_t handle, const Level c, const nlog::format_t<Args...> &format,
+                     Args &&...args) {
+    if (!enabled(handle, c)) {
+      return;
+    }
+    log_t *log_ident = resolve_(handle);
+    if (log_ident == nullptr || !writable_(log_ident)) {
+      return;
+    }
+    nlog::write(log_ident, c, format, std::forward<Args>(args)...);
+  }
+
+  template <fixed_string ident, typename... Args>
+  static void write_(const Level c, const nlog::format_t<Args...> &format, Args &&...args) {
+    if (c < min_level) {
+      return;
+    }
+    log_t *log_ident = find_<ident>();
+    if (log_ident == nullptr || !level_enabled_(log_ident, c) || !writable_(log_ident)) {
+      return;
+    }
+    nlog::write(log_ident, c, format, std::forward<Args>(args)...);
+  }
+
   /**
    * Generates a new session header string for logging purposes.
    *
@@ -370,80 +616,38 @@ private:
    */
   static bool is_stream_redirect_active_();
   static std::atomic<bool> stream_redirect_active_;
-
-  /**
-   * A specialized custom stream buffer that discards all inserted data.
-   *
-   * The `null_buffer_` class is a final class derived from `std::streambuf`,
-   * used specifically for creating a `null sink` that consumes and ignores
-   * any input without performing actual I/O operations. It is commonly used
-   * in scenarios where logging or output needs to be suppressed.
-   */
-  class null_buffer_ final : public std::streambuf {
-  public:
-    /**
-     * Handles the overflow of an input character in the stream buffer.
-     * This function is invoked by the stream buffer when an overflow
-     * operation occurs. It processes the input and determines the handling
-     * of the overflow situation.
-     *
-     * @param input The integer representation of the character to be handled
-     *              during overflow.
-     * @return The input value, unchanged.
-     */
-    int overflow(const int input) override { return input; }
-  };
-
-  /**
-   * A specialized logger class derived from `std::ostream` that performs no-op
-   * operations for all output streams redirected to it.
-   *
-   * This class is intended for use in cases where logging functionality must
-   * exist, but actual output is not required. It effectively discards any input
-   * given to it.
-   *
-   * The `null_logger_` leverages an internal `null_buffer_` that implements a
-   * stream buffer which discards all written data.
-   *
-   * @note Designed for scenarios where a placeholder logger is needed. It
-   * prevents unnecessary overhead caused by output redirection while
-   * maintaining interface compliance with standard logging practices.
-   *
-   * @note This class is final and cannot be inherited further.
-   */
-  class null_logger_ final : public std::ostream {
-  public:
-    /**
-     * Constructs an instance of `null_logger_`, which acts as a specialized
-     * output stream that discards all written data.
-     *
-     * This constructor initializes the `null_logger_` object by associating it
-     * with a `null_buffer_`, effectively ensuring that all output written to
-     * this stream is redirected to a sink that does nothing.
-     *
-     * @return An instance of `null_logger_` configured to silently discard any
-     * output.
-     */
-    null_logger_() : std::ostream(&null_buffer_) {}
-
-  private:
-    null_buffer_ null_buffer_;
-  };
-  /**
-   * A static global member of `null_logger_` type that serves as a no-op
-   * logger.
-   *
-   * This member is designed to silently discard any log messages sent to it. It
-   * is useful in scenarios where logging needs to be disabled or when a
-   * placeholder logger is required.
-   *
-   * By using `null_log_`, no output will be generated, and no resources will be
-   * consumed for formatting or storing log entries. This makes it an efficient
-   * logging sink for situations where logging is unnecessary.
-   *
-   * @note Intended for use when a logger is required for compatibility reasons,
-   *       but actual logging is not desired.
-   */
-  static null_logger_ null_log_;
 };
 } // namespace nutsloop
+
+// MARK: (LOG) level macros
+/**
+ * `NLOG_INFO(handle) << ...;` logs a record through `handle` at that level.
+ *
+ * When the level is off, at run time (see `log::set_level()`) or at compile
+ * time (see `NLOG_MIN_LEVEL`), the `<<` operands are not evaluated; below
+ * `NLOG_MIN_LEVEL` the statement is discarded altogether.
+ *
+ * The `F` variants take a format string and its arguments, as `log::info()`:
+ * `NLOG_INFOF(handle, "user {} took {}ms", id, ms);`
+ */
+#define NLOG_IF_(handle, c)                                                                        \
+  if constexpr (::nutsloop::c < ::nutsloop::min_level) {                                           \
+  } else if (!::nutsloop::log::enabled((handle), ::nutsloop::c)) {                                 \
+  } else
+
+#define NLOG_STREAM_(handle, c)                                                                    \
+  NLOG_IF_(handle, c)::nutsloop::log::stream((handle), NLOG_CALLSITE(::nutsloop::c))
+
+#define NLOG_TRACE(handle) NLOG_STREAM_(handle, TRACE)
+#define NLOG_DEBUG(handle) NLOG_STREAM_(handle, DEBUG)
+#define NLOG_INFO(handle) NLOG_STREAM_(handle, INFO)
+#define NLOG_WARN(handle) NLOG_STREAM_(handle, WARN)
+#define NLOG_ERROR(handle) NLOG_STREAM_(handle, ERROR)
+
+#define NLOG_TRACEF(handle, ...) NLOG_IF_(handle, TRACE)::nutsloop::log::trace((handle), __VA_ARGS__)
+#define NLOG_DEBUGF(handle, ...) NLOG_IF_(handle, DEBUG)::nutsloop::log::debug((handle), __VA_ARGS__)
+#define NLOG_INFOF(handle, ...) NLOG_IF_(handle, INFO)::nutsloop::log::info((handle), __VA_ARGS__)
+#define NLOG_WARNF(handle, ...) NLOG_IF_(handle, WARN)::nutsloop::log::warn((handle), __VA_ARGS__)
+#define NLOG_ERRORF(handle, ...) NLOG_IF_(handle, ERROR)::nutsloop::log::error((handle), __VA_ARGS__)
+
+#include "log/instance.h++"
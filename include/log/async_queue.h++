@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nutsloop::nlog {
+
+/**
+ * A bounded, lock-free, multi-producer/multi-consumer ring buffer.
+ *
+ * Every cell carries a sequence number telling producers and consumers
+ * whether the cell is free to be written or ready to be read, so neither
+ * side ever takes a lock. Producers are the logging threads; the consumer is
+ * the async_writer thread. Producers may also pop, which is how the
+ * `DROP_OLDEST` overflow policy makes room.
+ *
+ * @tparam T the queued type, it must be default constructible.
+ */
+template <typename T> class async_queue {
+public:
+  explicit async_queue(const std::size_t capacity)
+      : mask_{std::bit_ceil(capacity < 2 ? std::size_t{2} : capacity) - 1},
+        cells_{std::make_unique<cell_[]>(mask_ + 1)} {
+    for (std::size_t i = 0; i <= mask_; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  async_queue(const async_queue &) = delete;
+  async_queue &operator=(const async_queue &) = delete;
+
+  /**
+   * Claims a free cell and has `fill` write the new element in place, the
+   * cell keeps whatever its previous element left (e.g. the capacity of a
+   * string), so nothing is built, moved or allocated on the way.
+   *
+   * @param fill called as `fill(T &)` before the element is published, it
+   * must not throw: the cell it was given would never be published.
+   * @return false if the queue is full, `fill` is not called.
+   */
+  template <typename F> bool try_emplace(F &&fill) {
+    cell_ *cell;
+    std::size_t position = enqueue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[position & mask_];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+      if (diff == 0) {
+        if (enqueue_position_.compare_exchange_weak(position, position + 1,
+                                                    std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    fill(cell->value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Claims the oldest queued element and has `consume` read it in place.
+   *
+   * @param consume called as `consume(T &)` before the cell is handed back
+   * to the producers, which happens even if it throws.
+   * @return false if the queue is empty, `consume` is not called.
+   */
+  template <typename F> bool try_consume(F &&consume) {
+    cell_ *cell;
+    std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    for (;;) {
+      cell = &cells_[position & mask_];
+      const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+      if (diff == 0) {
+        if (dequeue_position_.compare_exchange_weak(position, position + 1,
+                                                    std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+    // HINT: a cell never handed back would stall every producer for good.
+    const release_ release{cell->sequence, position + mask_ + 1};
+    consume(cell->value);
+    return true;
+  }
+
+  /**
+   * Whether the next element to pop is missing; the answer may already be
+   * stale when it is returned if other threads are pushing.
+   */
+  [[nodiscard]] bool empty() const {
+    const std::size_t position = dequeue_position_.load(std::memory_order_acquire);
+    return cells_[position & mask_].sequence.load(std::memory_order_acquire) != position + 1;
+  }
+
+  [[nodiscard]] std::size_t capacity() const { return mask_ + 1; }
+
+private:
+  struct cell_ {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  /**
+   * Stores `sequence` into the cell when it goes out of scope.
+   */
+  struct release_ {
+    std::atomic<std::size_t> &cell;
+    const std::size_t sequence;
+
+    ~release_() { cell.store(sequence, std::memory_order_release); }
+  };
+
+  const std::size_t mask_;
+  const std::unique_ptr<cell_[]> cells_;
+  // HINT: kept on separate cache lines so producers and the consumer don't
+  //  bounce the same line between cores.
+  alignas(64) std::atomic<std::size_t> enqueue_position_{0};
+  alignas(64) std::atomic<std::size_t> dequeue_position_{0};
+};
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "log/async_queue.h++"
+#include "types.h++"
+#include "util/level.h++"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace nutsloop::nlog {
+
+using namespace nlog::types;
+
+/**
+ * Renders the text of a deferred record, appending it to `out`.
+ *
+ * @param payload the bytes pushed by the logging thread.
+ * @param out the batch being written by the writer thread.
+ */
+using render_fn = void (*)(std::string_view payload, std::string &out);
+
+/**
+ * Encodes a deferred record in place.
+ *
+ * @param out where the payload goes, as many bytes as announced to `push()`.
+ * @param context what to encode, owned by the logging thread.
+ */
+using encode_fn = void (*)(char *out, const void *context);
+
+/**
+ * The asynchronous backend of a log.
+ *
+ * Logging threads push complete records (see `record`) into a lock-free
+ * `async_queue`, a dedicated thread pops them, concatenates them into one
+ * large buffer and writes the buffer to the log sink with a single call. The
+ * logging threads never touch the file.
+ *
+ * A record can also be pushed in its deferred form: the raw bytes of its
+ * arguments along with the function able to render them, so that formatting
+ * happens on the writer thread too (see `nlog::write()`).
+ *
+ * One `async_writer` is created by `log::set()` for every log whose
+ * `log_settings_t::get_async().enabled` is true and it lives in `log_t`.
+ */
+class async_writer {
+public:
+  /**
+   * @param rotation the rotation of the log, told about every batch written,
+   * nullptr when the log is not rotated.
+   */
+  async_writer(sink &sink, std::mutex &io_mtx, const async_settings_t &settings,
+               rotation *rotation = nullptr);
+  /**
+   * Stops the writer thread after every queued record has been written.
+   */
+  ~async_writer();
+
+  async_writer(const async_writer &) = delete;
+  async_writer &operator=(const async_writer &) = delete;
+
+  /**
+   * Queues one complete record, applying the overflow policy when the queue
+   * is full. Records pushed after `stop()` are dropped.
+   *
+   * @param record the record, newline included, or its deferred payload;
+   * it is copied into the queue.
+   * @param render the function rendering a deferred payload, nullptr when
+   * `record` is already text.
+   * @param level the level of the record, a batch holding an `ERROR` record
+   * may flush the sink.
+   */
+  void push(std::string_view record, render_fn render = nullptr, Level level = NONE);
+  /**
+   * Queues one deferred record, `encode` writes its payload straight into
+   * the queue cell; otherwise the same as the overload above.
+   *
+   * @param size the size of the payload.
+   */
+  void push(std::size_t size, encode_fn encode, const void *context, render_fn render,
+            Level level);
+  /**
+   * Blocks until every record pushed before the call has been written to the
+   * file (or dropped).
+   */
+  void drain();
+  /**
+   * Drains the queue and joins the writer thread, once every push already
+   * under way has queued its record. Only the first call does anything.
+   */
+  void stop();
+
+  [[nodiscard]] std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  /**
+   * The most records ever found waiting in the queue, sampled by the writer
+   * thread before every batch.
+   */
+  [[nodiscard]] std::uint64_t high_water() const {
+    return high_water_.load(std::memory_order_relaxed);
+  }
+
+private:
+  // HINT: records are concatenated up to this size before being written.
+  static constexpr std::size_t batch_size_ = 64 * 1024;
+
+  sink &sink_;
+  // HINT: log_t::io_mtx, shared with log::flush() and log::close().
+  std::mutex &io_mtx_;
+  rotation *const rotation_;
+  const overflow_policy_t overflow_;
+  // HINT: lives in its queue cell for good, records are copied in and read
+  //  out in place (see `async_queue::try_emplace()`).
+  struct entry_t {
+    // HINT: most records fit the cell itself, longer ones go to `heap`,
+    //  whose capacity the cell keeps for its next record.
+    static constexpr std::size_t inline_size = 256;
+
+    std::array<char, inline_size> inline_data;
+    std::string heap;
+    std::size_t size{0};
+    render_fn render{nullptr};
+    Level level{NONE};
+    // HINT: set when the record could not be copied in, the writer thread
+    //  counts it as dropped.
+    bool failed{false};
+
+    /**
+     * Makes room for `bytes` bytes and returns where to write them.
+     */
+    char *reserve(const std::size_t bytes) {
+      size = bytes;
+      if (bytes <= inline_size) {
+        return inline_data.data();
+      }
+      heap.resize(bytes);
+      return heap.data();
+    }
+    [[nodiscard]] std::string_view view() const {
+      return size <= inline_size ? std::string_view{inline_data.data(), size}
+                                 : std::string_view{heap};
+    }
+  };
+
+  async_queue<entry_t> queue_;
+
+  std::atomic<std::uint64_t> pushed_{0};
+  std::atomic<std::uint64_t> consumed_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> high_water_{0};
+
+  std::atomic<std::uint32_t> wake_{0};
+  std::atomic<bool> sleeping_{false};
+  // HINT: the pushes under way, stop() waits for them before closing.
+  std::atomic<std::uint32_t> producers_{0};
+  // HINT: set by stop(), pushes from then on are dropped.
+  std::atomic<bool> stopping_{false};
+  // HINT: set by stop() once no push is under way, the writer thread returns
+  //  when it finds the queue empty.
+  std::atomic<bool> closed_{false};
+  // HINT: declared last, the thread starts once everything above is built.
+  std::thread thread_;
+
+  void run_();
+  /**
+   * Wakes the writer thread up.
+   *
+   * @param force when false the writer is only signalled if it is asleep,
+   * which keeps the common push path free of syscalls.
+   */
+  void wake_up_(bool force = false);
+};
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * The binary encoding of a log file, see `encoding_t::BINARY`.
+ *
+ * Numbers are written in the byte order of the machine writing the file.
+ *
+ * ```
+ * file     := magic version:u16 frame*
+ * frame    := type:u8 size:u32 body[size]
+ *
+ * RECORD   := time:u64 thread:u64 site:u64 format:u64 format_size:u32 level:u8 payload
+ *             payload is the text of the record when `format` is 0,
+ *             the typed arguments of the format otherwise: (tag:u8 value)*
+ * CALLSITE := site:u64 level:u8 line:u32 file
+ * FORMAT   := format:u64 text
+ * SYNC     := sync_marker time:u64
+ * ```
+ *
+ * `time` is in nanoseconds since the epoch. `site` and `format` are ids
+ * declared by a `CALLSITE` and a `FORMAT` frame before the first record using
+ * them. Every `SYNC` frame forgets the declarations, so that reading can start
+ * at any `SYNC` frame: they are written every `sync_interval` bytes and their
+ * `time` only grows, which makes a file searchable by time with a bisection.
+ */
+namespace nutsloop::nlog::binary {
+
+constexpr std::array<char, 8> magic{'N', 'L', 'O', 'G', 'B', 'I', 'N', '1'};
+constexpr std::uint16_t version = 1;
+constexpr std::size_t file_header_size = magic.size() + sizeof(version);
+
+// HINT: searched for when bisecting, unlikely to appear in a record.
+constexpr std::array<unsigned char, 16> sync_marker{0xa7, 0x4e, 0x4c, 0x4f, 0x47, 0x53, 0x59, 0x4e,
+                                                    0x43, 0x1f, 0xd3, 0x6b, 0x02, 0xe9, 0x8c, 0x5d};
+constexpr std::size_t sync_interval = 1024 * 1024;
+
+enum class frame_t : std::uint8_t { RECORD = 1, CALLSITE = 2, FORMAT = 3, SYNC = 4 };
+enum class field_t : std::uint8_t { I64 = 1, U64 = 2, F64 = 3, BOOL = 4, CHAR = 5, STRING = 6 };
+
+constexpr std::size_t frame_header_size = sizeof(std::uint8_t) + sizeof(std::uint32_t);
+constexpr std::size_t record_header_size = 4 * sizeof(std::uint64_t) + sizeof(std::uint32_t) +
+                                           sizeof(std::uint8_t);
+// HINT: where the payload of a record frame starts.
+constexpr std::size_t record_offset = frame_header_size + record_header_size;
+constexpr std::size_t sync_size = frame_header_size + sync_marker.size() + sizeof(std::uint64_t);
+
+template <typename T> void store(char *&cursor, const T value) {
+  std::memcpy(cursor, &value, sizeof(T));
+  cursor += sizeof(T);
+}
+
+template <typename T> T load(const char *&cursor) {
+  T value;
+  std::memcpy(&value, cursor, sizeof(T));
+  cursor += sizeof(T);
+  return value;
+}
+
+struct record_header_t {
+  std::uint64_t time;
+  std::uint64_t thread;
+  std::uint64_t site;
+  std::uint64_t format;
+  std::uint32_t format_size;
+  std::uint8_t level;
+};
+
+/**
+ * Writes the frame header and the record header at the beginning of a
+ * record frame of `frame_size` bytes.
+ */
+inline void store_record(char *frame, const std::size_t frame_size, const record_header_t &header) {
+  store(frame, frame_t::RECORD);
+  store(frame, static_cast<std::uint32_t>(frame_size - frame_header_size));
+  store(frame, header.time);
+  store(frame, header.thread);
+  store(frame, header.site);
+  store(frame, header.format);
+  store(frame, header.format_size);
+  store(frame, header.level);
+}
+
+/**
+ * Reads the record header of the record frame starting at `frame`.
+ */
+inline record_header_t load_record(const char *frame) {
+  frame += frame_header_size;
+  record_header_t header; // NOLINT(*-init-variables)
+  header.time = load<std::uint64_t>(frame);
+  header.thread = load<std::uint64_t>(frame);
+  header.site = load<std::uint64_t>(frame);
+  header.format = load<std::uint64_t>(frame);
+  header.format_size = load<std::uint32_t>(frame);
+  header.level = load<std::uint8_t>(frame);
+  return header;
+}
+
+/**
+ * Where the frames of `file` end: past the last whole frame, before the
+ * zeroes an unclosed MMAP sink leaves or a frame cut short by a crash.
+ *
+ * A frame may end with zero bytes (an integer 0, `false`, the size of an
+ * empty string), the frames have to be walked to find their end.
+ */
+inline std::size_t end_of(const std::string_view file) {
+  if (file.size() < file_header_size ||
+      std::memcmp(file.data(), magic.data(), magic.size()) != 0) {
+    // not a binary log yet, it ends at the last byte that is not zero.
+    std::size_t end = file.size();
+    while (end > 0 && file[end - 1] == '\0') {
+      --end;
+    }
+    return end;
+  }
+
+  std::size_t offset = file_header_size;
+  while (offset + frame_header_size <= file.size() && file[offset] != '\0') {
+    const char *cursor = file.data() + offset + sizeof(std::uint8_t);
+    const auto size = load<std::uint32_t>(cursor);
+    if (file.size() - offset - frame_header_size < size) {
+      break;
+    }
+    offset += frame_header_size + size;
+  }
+  return offset;
+}
+
+inline std::uint64_t now() {
+  return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::system_clock::now().time_since_epoch())
+                                        .count());
+}
+
+/**
+ * The id of the calling thread, as shown by the system.
+ */
+inline std::uint64_t thread_id() {
+  thread_local const auto id = static_cast<std::uint64_t>(::syscall(SYS_gettid));
+  return id;
+}
+
+// HINT: the arguments written as typed fields, anything else makes the whole
+//  record text.
+template <typename T>
+concept encodable_ = std::is_arithmetic_v<T> || std::same_as<T, std::string> ||
+                     std::same_as<T, std::string_view> || std::same_as<T, const char *> ||
+                     std::same_as<T, char *> ||
+                     (std::is_array_v<T> && std::same_as<std::remove_extent_t<T>, char>);
+
+template <typename T> constexpr field_t field_of() {
+  if constexpr (std::same_as<T, bool>) {
+    return field_t::BOOL;
+  } else if constexpr (std::same_as<T, char>) {
+    return field_t::CHAR;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return field_t::F64;
+  } else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    return field_t::I64;
+  } else if constexpr (std::is_integral_v<T>) {
+    return field_t::U64;
+  } else {
+    return field_t::STRING;
+  }
+}
+
+} // namespace nutsloop::nlog::binary
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "log/binary.h++"
+#include "log/sink.h++"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace nutsloop::nlog {
+
+/**
+ * A sink writing the frames of a binary log (see `encoding_t::BINARY`) to
+ * another sink.
+ *
+ * Records reach it as complete `RECORD` frames, built by `record`. Before the
+ * first record of a call site or of a format string, it writes the `CALLSITE`
+ * or `FORMAT` frame declaring it, and every `binary::sync_interval` bytes a
+ * `SYNC` frame, after which everything is declared again. Opening a file
+ * writes the file header when the file is empty, then a `SYNC` frame.
+ *
+ * Flushing is left to the wrapped sink and its `flush_policy_t`.
+ */
+class binary_sink final : public sink {
+public:
+  explicit binary_sink(std::shared_ptr<sink> inner);
+  ~binary_sink() override;
+
+  bool open(const std::filesystem::path &path, bool truncate) override;
+  void close() override;
+  [[nodiscard]] bool is_open() const override { return inner_->is_open(); }
+  /**
+   * The counters of the wrapped sink, which writes the file.
+   */
+  [[nodiscard]] counters_t counters() const override { return inner_->counters(); }
+
+protected:
+  void write_(std::string_view data) override;
+  void flush_() override;
+  void sync_() override;
+
+private:
+  const std::shared_ptr<sink> inner_;
+  // HINT: the ids declared since the last SYNC frame.
+  std::unordered_set<std::uint64_t> sites_;
+  std::unordered_set<std::uint64_t> formats_;
+  std::size_t unsynced_{0};
+  std::string frames_;
+
+  /**
+   * Writes the `CALLSITE` and `FORMAT` frames `header` needs.
+   */
+  void declare_(const binary::record_header_t &header);
+  /**
+   * Writes a `SYNC` frame and forgets every declaration.
+   */
+  void mark_();
+  /**
+   * Writes `frames_` to the wrapped sink and empties it.
+   */
+  void emit_();
+};
+
+} // namespace nutsloop::nlog
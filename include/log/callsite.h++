@@ -0,0 +1,62 @@
+#pragma once
+
+#include "util/level.h++"
+
+#include <string>
+
+namespace nutsloop::nlog {
+
+/**
+ * The metadata of a logging call site, computed once.
+ *
+ * The prefix of every record, `[LEVEL] [file:line]`, only depends on where
+ * the record is logged from: it is built the first time a call site logs,
+ * and every following call reuses it, with no formatting, allocation or
+ * system call.
+ */
+struct callsite_t {
+  Level level;
+  const char *file;
+  int line;
+  // HINT: `[LEVEL] [shortened/file:line]`
+  std::string prefix;
+};
+
+/**
+ * Returns the descriptor of a call site, creating it on first use.
+ *
+ * Descriptors are never destroyed, the reference stays valid for the whole
+ * program. Lookups go through a small per-thread cache first, then through a
+ * registry shared by all threads; both are keyed by the contents of `file`,
+ * so it may be any string, even one that is about to be freed: the
+ * descriptor keeps a copy of it.
+ *
+ * @param file the source file, nullptr when unknown.
+ * @param line the source line, 0 when unknown.
+ * @param c the level of the records logged from the call site.
+ */
+const callsite_t &callsite(const char *file, int line, Level c);
+
+/**
+ * The same as `callsite()`, the per-thread cache being keyed by the address
+ * of `file` instead of its contents, which saves hashing it on every call.
+ *
+ * @param file the source file, it must have static storage duration, as
+ * `__FILE__` and `std::source_location::file_name()` have.
+ */
+const callsite_t &static_callsite(const char *file, int line, Level c);
+
+} // namespace nutsloop::nlog
+
+/**
+ * Expands to the `callsite_t` of the line it is written on.
+ *
+ * The descriptor is held by a function-local static, after the first call
+ * resolving it costs a single check of the static's guard.
+ */
+#define NLOG_CALLSITE(level)                                                                       \
+  ([]() -> const ::nutsloop::nlog::callsite_t & {                                                  \
+    static const ::nutsloop::nlog::callsite_t &site =                                              \
+        ::nutsloop::nlog::static_callsite(__FILE__, __LINE__, level);                              \
+    return site;                                                                                   \
+  }())
@@ -0,0 +1,209 @@
+#pragma once
+
+#include "log/async_writer.h++"
+#include "log/binary.h++"
+#include "log/callsite.h++"
+#include "log/record.h++"
+#include "types.h++"
+#include "util/level.h++"
+
+#include <concepts>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace nutsloop::nlog {
+
+using namespace nlog::types;
+
+/**
+ * A format string checked against its arguments at compile time, carrying
+ * the location of the call that produced it.
+ *
+ * It is the first parameter of `log::info()`, `log::warn()`, `log::error()`:
+ * a literal passed there is validated by `std::format_string` while
+ * compiling, and `std::source_location::current()` is evaluated at the call
+ * site, so no `__FILE__`/`__LINE__` needs to be spelled out.
+ */
+template <typename... Args> struct basic_format_t {
+  template <typename T>
+    requires std::convertible_to<const T &, std::string_view>
+  // NOLINTNEXTLINE(*-explicit-constructor)
+  consteval basic_format_t(const T &format,
+                           const std::source_location location = std::source_location::current())
+      : string{format}, location{location} {}
+
+  std::format_string<Args...> string;
+  std::source_location location;
+};
+
+// HINT: the arguments are deduced from the values only, as for std::format.
+template <typename... Args> using format_t = basic_format_t<std::type_identity_t<Args>...>;
+
+// HINT: values that can be copied as raw bytes and formatted later, on the
+//  writer thread. Anything else is formatted by the calling thread.
+template <typename T>
+concept deferrable_arithmetic_ = std::is_arithmetic_v<T>;
+template <typename T>
+concept deferrable_string_ = std::same_as<T, std::string> || std::same_as<T, std::string_view> ||
+                             std::same_as<T, const char *> || std::same_as<T, char *> ||
+                             (std::is_array_v<T> && std::same_as<std::remove_extent_t<T>, char>);
+template <typename T>
+concept deferrable_ = deferrable_arithmetic_<T> || deferrable_string_<T>;
+
+/**
+ * The fixed part of a deferred payload, followed by the raw arguments.
+ */
+struct deferred_header_t {
+  const char *format;
+  std::size_t format_size;
+  const callsite_t *site;
+};
+
+// HINT: what a deferred argument is held as between measuring and encoding,
+//  strings are only measured once.
+template <typename T>
+using deferred_value_t = std::conditional_t<deferrable_arithmetic_<T>, T, std::string_view>;
+
+template <typename T> std::size_t encoded_size_(const T &value) {
+  if constexpr (deferrable_arithmetic_<T>) {
+    return sizeof(T);
+  } else {
+    return sizeof(std::size_t) + value.size();
+  }
+}
+
+template <typename T> void encode_(char *&cursor, const T &value) {
+  if constexpr (deferrable_arithmetic_<T>) {
+    std::memcpy(cursor, &value, sizeof(T));
+    cursor += sizeof(T);
+  } else {
+    const std::size_t size = value.size();
+    std::memcpy(cursor, &size, sizeof(size));
+    cursor += sizeof(size);
+    std::memcpy(cursor, value.data(), size);
+    cursor += size;
+  }
+}
+
+/**
+ * A deferred record on the stack of the logging thread, until
+ * `encode_payload_` writes it into its queue cell.
+ */
+template <typename... Args> struct deferred_t {
+  deferred_header_t header;
+  std::tuple<deferred_value_t<Args>...> values;
+};
+
+/**
+ * The `encode_fn` of the payloads of `Args`, run by the logging thread.
+ */
+template <typename... Args> void encode_payload_(char *out, const void *context) {
+  const auto &deferred = *static_cast<const deferred_t<Args...> *>(context);
+  std::memcpy(out, &deferred.header, sizeof(deferred.header));
+  out += sizeof(deferred.header);
+  std::apply([&](const auto &...value) { (encode_(out, value), ...); }, deferred.values);
+}
+
+template <typename T> auto decode_(const char *&cursor) {
+  if constexpr (deferrable_arithmetic_<T>) {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+  } else {
+    std::size_t size;
+    std::memcpy(&size, cursor, sizeof(size));
+    cursor += sizeof(size);
+    const std::string_view view{cursor, size};
+    cursor += size;
+    return view;
+  }
+}
+
+/**
+ * The `render_fn` of the payloads encoded for `Args`, run by the writer
+ * thread.
+ */
+template <typename... Args> void render_(const std::string_view payload, std::string &out) {
+
+  deferred_header_t header; // NOLINT(*-init-variables)
+  std::memcpy(&header, payload.data(), sizeof(header));
+  const char *cursor = payload.data() + sizeof(header);
+
+  out.append(header.site->prefix);
+  out.push_back(' ');
+  // HINT: the elements of a braced list are evaluated in order.
+  std::tuple<decltype(decode_<Args>(cursor))...> values{decode_<Args>(cursor)...};
+  std::apply(
+      [&](auto &...value) {
+        std::vformat_to(std::back_inserter(out),
+                        std::string_view{header.format, header.format_size},
+                        std::make_format_args(value...));
+      },
+      values);
+  out.push_back('\n');
+}
+
+/**
+ * Writes one line to a log, formatting `format` with `args`.
+ *
+ * When the log is asynchronous and every argument is deferrable, the calling
+ * thread only copies the format string address, the call site descriptor and the raw
+ * bytes of the arguments into the queue; the text is built by the writer
+ * thread. Otherwise the line is formatted in a `record` and committed at once.
+ *
+ * A binary log gets the arguments as typed fields when they all have one, see
+ * `binary::encodable_`, and the formatted text otherwise.
+ *
+ * @param log the log, it must be writable.
+ * @param c the level of the line.
+ * @param format the format string, checked at compile time.
+ * @param args the arguments.
+ */
+template <typename... Args>
+void write(log_t *log, const Level c, const format_t<Args...> &format, Args &&...args) {
+
+  const callsite_t &site =
+      static_callsite(format.location.file_name(), static_cast<int>(format.location.line()), c);
+
+  if (log->settings.get_encoding() == encoding_t::BINARY) {
+    record frame{log, &site};
+    if constexpr ((binary::encodable_<std::remove_cvref_t<Args>> && ...)) {
+      frame.encode(format.string.get(), args...);
+    } else {
+      frame.format(format.string, std::forward<Args>(args)...);
+    }
+    return;
+  }
+
+  if constexpr ((deferrable_<std::remove_cvref_t<Args>> && ...)) {
+    if (log->writer != nullptr) {
+      const std::string_view format_string = format.string.get();
+      const deferred_t<std::remove_cvref_t<Args>...> deferred{
+          {format_string.data(), format_string.size(), &site}, {args...}};
+      const std::size_t size = std::apply(
+          [](const auto &...value) {
+            return sizeof(deferred_header_t) + (encoded_size_(value) + ... + 0);
+          },
+          deferred.values);
+      // HINT: encoded straight into the queue cell, the heap is only used by
+      //  payloads too large for it (see `async_writer::entry_t`).
+      log->writer->push(size, &encode_payload_<std::remove_cvref_t<Args>...>, &deferred,
+                        &render_<std::remove_cvref_t<Args>...>, c);
+      return;
+    }
+  }
+
+  record line{log, &site};
+  line << ' ';
+  line.format(format.string, std::forward<Args>(args)...);
+  line << '\n';
+}
+
+} // namespace nutsloop::nlog
@@ -1,5 +1,9 @@
 #pragma once
 
+#include "log.h++"
+#include "log/callsite.h++"
+#include "log/format.h++"
+#include "log/record.h++"
 #include "types.h++"
 
 namespace nutsloop::nlog {
@@ -7,6 +11,12 @@ namespace nutsloop::nlog {
 using namespace nutsloop::nlog::types;
 
 // TODO: DEBUG_LOG
+/**
+ * A log bound by its handle, see `log::get_instance()`.
+ *
+ * Every record goes through `log::stream(handle_t)`, so an instance costs no
+ * lookup by identifier and still honours the state of the log.
+ */
 class instance{
 public:
   explicit instance( log_t* log );
@@ -23,12 +33,35 @@ public:
   };
 
   // MARK: (log_instance) log_t
-  [[nodiscard]] std::ostream& ostream() const;
+  [[nodiscard]] handle_t handle() const { return handle_t{ log_->handle }; }
+  // HINT: a record, committed with a single write at the end of the expression.
+  [[nodiscard]] record ostream() const;
+  [[nodiscard]] record stream( const callsite_t& site ) const;
+
+  template <typename... Args> void trace( format_t<Args...> format, Args &&...args ) const {
+    log::trace( handle(), format, std::forward<Args>( args )... );
+  }
+  template <typename... Args> void debug( format_t<Args...> format, Args &&...args ) const {
+    log::debug( handle(), format, std::forward<Args>( args )... );
+  }
+  template <typename... Args> void info( format_t<Args...> format, Args &&...args ) const {
+    log::info( handle(), format, std::forward<Args>( args )... );
+  }
+  template <typename... Args> void warn( format_t<Args...> format, Args &&...args ) const {
+    log::warn( handle(), format, std::forward<Args>( args )... );
+  }
+  template <typename... Args> void error( format_t<Args...> format, Args &&...args ) const {
+    log::error( handle(), format, std::forward<Args>( args )... );
+  }
   // HINT: not implemented yet.
   [[nodiscard]] bool running() const = delete;
 
   // MARK: (log_instance) manipulation
 
+  void level( const Level c ) const { log::set_level( handle(), c ); }
+  [[nodiscard]] Level level() const { return log::get_level( handle() ); }
+  [[nodiscard]] counters_t counters() const { return log::counters( handle() ); }
+
   void start() const;
   void stop() const;
   void flush() const;
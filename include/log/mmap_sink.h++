@@ -0,0 +1,52 @@
+#pragma once
+
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+/**
+ * A sink copying records into a file mapped in memory.
+ *
+ * The file is grown by `sink_settings_t::segment_size` bytes at a time and
+ * mapped as a whole; a record is a `memcpy` into the mapping. Memory written
+ * to a shared mapping belongs to the kernel page cache, so the records
+ * survive a crash of the program. Until the sink is closed, the file ends
+ * with zeroes past the last record; opening it again appends after the last
+ * record. If the file cannot be grown, the sink closes itself.
+ */
+class mmap_sink final : public sink {
+public:
+  explicit mmap_sink(const sink_settings_t &settings);
+  ~mmap_sink() override;
+
+  bool open(const std::filesystem::path &path, bool truncate) override;
+  /**
+   * Unmaps the file and truncates it to the records written.
+   */
+  void close() override;
+  [[nodiscard]] bool is_open() const override { return fd_ >= 0; }
+
+protected:
+  void write_(std::string_view data) override;
+  /**
+   * Nothing to do, the records are in the page cache already.
+   */
+  void flush_() override {}
+  void sync_() override;
+
+private:
+  int fd_{-1};
+  const std::size_t segment_;
+  char *map_{nullptr};
+  std::size_t mapped_{0};
+  std::size_t size_{0};
+
+  /**
+   * Grows the file and its mapping to hold at least `needed` bytes.
+   *
+   * @return false if the file could not be grown or mapped.
+   */
+  bool grow_(std::size_t needed);
+};
+
+} // namespace nutsloop::nlog
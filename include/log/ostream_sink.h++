@@ -0,0 +1,38 @@
+#pragma once
+
+#include "log/sink.h++"
+
+#include <fstream>
+
+namespace nutsloop::nlog {
+
+/**
+ * A sink writing through a `std::ofstream`, the default one.
+ */
+class ostream_sink final : public sink {
+public:
+  explicit ostream_sink(const sink_settings_t &settings);
+  ~ostream_sink() override;
+
+  bool open(const std::filesystem::path &path, bool truncate) override;
+  void close() override;
+  [[nodiscard]] bool is_open() const override { return stream_.is_open(); }
+
+protected:
+  void write_(std::string_view data) override;
+  void flush_() override;
+  /**
+   * A `std::ofstream` has no file descriptor to sync, the one kept by
+   * `open()` for the purpose is synced.
+   */
+  void sync_() override;
+
+private:
+  std::ofstream stream_;
+  std::filesystem::path path_;
+  // HINT: opened before the stream, which then opens the very same file
+  //  through /proc/self/fd, whatever happens to `path_` afterwards.
+  int fd_{-1};
+};
+
+} // namespace nutsloop::nlog
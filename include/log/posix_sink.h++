@@ -0,0 +1,43 @@
+#pragma once
+
+#include "log/sink.h++"
+
+#include <memory>
+
+struct iovec;
+
+namespace nutsloop::nlog {
+
+/**
+ * A sink writing to a file descriptor through a large buffer.
+ *
+ * Records are copied into the buffer; a record that does not fit is written
+ * along with the buffer by a single `writev`, without being copied.
+ */
+class posix_sink final : public sink {
+public:
+  explicit posix_sink(const sink_settings_t &settings);
+  ~posix_sink() override;
+
+  bool open(const std::filesystem::path &path, bool truncate) override;
+  void close() override;
+  [[nodiscard]] bool is_open() const override { return fd_ >= 0; }
+
+protected:
+  void write_(std::string_view data) override;
+  void flush_() override;
+  void sync_() override;
+
+private:
+  int fd_{-1};
+  const std::size_t capacity_;
+  const std::unique_ptr<char[]> buffer_;
+  std::size_t size_{0};
+
+  /**
+   * Writes every byte of `vectors`, retrying on short writes.
+   */
+  void writev_(iovec *vectors, int count);
+};
+
+} // namespace nutsloop::nlog
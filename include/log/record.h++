@@ -0,0 +1,200 @@
+#pragma once
+
+#include "log/binary.h++"
+#include "log/callsite.h++"
+#include "types.h++"
+#include "util/level.h++"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <format>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+namespace nutsloop::nlog {
+
+using namespace nlog::types;
+
+// HINT: integers written with std::to_chars, character types are excluded so
+//  that they keep being written as characters.
+template <typename T>
+concept record_integer_ = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) > 1 &&
+                          !std::is_same_v<T, wchar_t> && !std::is_same_v<T, char16_t> &&
+                          !std::is_same_v<T, char32_t>;
+
+/**
+ * A single log record, built in place and committed as a whole.
+ *
+ * `log::stream()` and `instance::ostream()` return a temporary `record`; every
+ * `<<` appends to a buffer living inside the record itself, falling back to the
+ * heap only when a record outgrows it. When the temporary is destroyed, at the
+ * end of the full expression, the buffer is written to the file with a single
+ * call (or queued, for asynchronous logs), so lines logged by different
+ * threads never tear into each other.
+ *
+ * ```c++
+ * log::stream("log", __FILE__, __LINE__) << "user " << id << " logged in" << '\n';
+ * //                                                                   committed here ⇡
+ * ```
+ *
+ * A default constructed record is a null record: it discards everything
+ * without formatting it.
+ *
+ * In a binary log (see `encoding_t::BINARY`) the record is a `RECORD` frame:
+ * the buffer starts with room for the frame header, filled when committing,
+ * and the text, or the typed fields written by `encode()`, follow.
+ *
+ * @note a record must not outlive the log it has been created from.
+ */
+class record {
+public:
+  // HINT: size of the buffer embedded in the record, longer records move to
+  //  the heap.
+  static constexpr std::size_t inline_size = 512;
+
+  record() = default;
+  /**
+   * @param log the log the record is committed to.
+   * @param site where the record is logged from, its prefix starts a text
+   * record and its level is the level of the record (an `ERROR` record may
+   * flush the sink, see `flush_policy_t`). Without it the record has neither.
+   */
+  explicit record(log_t *log, const callsite_t *site = nullptr);
+  /**
+   * Commits the record to its log, unless it is a null or an empty record.
+   */
+  ~record();
+
+  // HINT: a record is only ever handed out as a prvalue.
+  record(const record &) = delete;
+  record &operator=(const record &) = delete;
+
+  template <typename T> record &operator<<(const T &value) {
+
+    if (log_ == nullptr) {
+      return *this;
+    }
+
+    // once a manipulator has been applied every insertion goes through the
+    // stream, so that its format flags are honoured.
+    if (fallback_.has_value()) {
+      *fallback_ << value;
+    } else if constexpr (std::is_same_v<T, char>) {
+      buffer_.append(&value, 1);
+    } else if constexpr (std::is_convertible_v<const T &, std::string_view>) {
+      const std::string_view view = value;
+      buffer_.append(view.data(), view.size());
+    } else if constexpr (record_integer_<T>) {
+      std::array<char, 40> digits; // NOLINT(*-pro-type-member-init)
+      const char *end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+      buffer_.append(digits.data(), static_cast<std::size_t>(end - digits.data()));
+    } else {
+      fallback_stream_() << value;
+    }
+
+    return *this;
+  }
+
+  /**
+   * Appends `format` formatted with `args`, the format string is checked at
+   * compile time.
+   */
+  template <typename... Args> record &format(std::format_string<Args...> format, Args &&...args) {
+    if (log_ != nullptr) {
+      std::format_to(std::ostreambuf_iterator<char>(&buffer_), format, std::forward<Args>(args)...);
+    }
+    return *this;
+  }
+
+  /**
+   * Writes the arguments of `format` as typed fields, for a binary record;
+   * the text is left to whoever reads the log.
+   *
+   * @param format the format string, it must outlive the program (a literal).
+   */
+  template <typename... Args> record &encode(const std::string_view format, const Args &...args) {
+    if (log_ != nullptr && binary_) {
+      format_ = format;
+      (encode_field_<std::remove_cvref_t<Args>>(args), ...);
+    }
+    return *this;
+  }
+
+  record &operator<<(std::ostream &(*manipulator)(std::ostream &));
+  record &operator<<(std::ios_base &(*manipulator)(std::ios_base &));
+
+  /**
+   * The content formatted so far.
+   */
+  [[nodiscard]] std::string_view view() const { return buffer_.view(); }
+
+private:
+  /**
+   * A stream buffer writing into an inline array, moving to a heap
+   * allocation, grown geometrically, once the array is full.
+   */
+  class buffer_t final : public std::streambuf {
+  public:
+    buffer_t() { setp(inline_.data(), inline_.data() + inline_.size()); }
+
+    buffer_t(const buffer_t &) = delete;
+    buffer_t &operator=(const buffer_t &) = delete;
+
+    void append(const char *data, std::size_t size);
+    [[nodiscard]] std::string_view view() const {
+      return {pbase(), static_cast<std::size_t>(pptr() - pbase())};
+    }
+    [[nodiscard]] char *data() const { return pbase(); }
+
+  protected:
+    int overflow(int input) override;
+    std::streamsize xsputn(const char *input, std::streamsize count) override;
+
+  private:
+    std::array<char, inline_size> inline_; // NOLINT(*-pro-type-member-init)
+    std::unique_ptr<char[]> heap_{nullptr};
+
+    void grow_(std::size_t needed);
+  };
+
+  log_t *log_{nullptr};
+  const callsite_t *site_{nullptr};
+  Level level_{NONE};
+  bool binary_{false};
+  // HINT: the format of the typed fields, empty for a text record.
+  std::string_view format_;
+  buffer_t buffer_;
+  // HINT: only built for types without a fast path or when manipulators are
+  //  used, constructing a std::ostream is not free.
+  std::optional<std::ostream> fallback_;
+
+  std::ostream &fallback_stream_();
+  void commit_();
+
+  template <typename T> void encode_field_(const T &value) {
+    constexpr binary::field_t field = binary::field_of<T>();
+    buffer_.append(reinterpret_cast<const char *>(&field), sizeof(field));
+    if constexpr (field == binary::field_t::STRING) {
+      const std::string_view view = value;
+      const auto size = static_cast<std::uint32_t>(view.size());
+      buffer_.append(reinterpret_cast<const char *>(&size), sizeof(size));
+      buffer_.append(view.data(), view.size());
+    } else {
+      // HINT: every number is widened to 64 bits, the reader knows no other.
+      using wide_t = std::conditional_t<
+          field == binary::field_t::F64, double,
+          std::conditional_t<field == binary::field_t::I64, std::int64_t,
+                             std::conditional_t<field == binary::field_t::U64, std::uint64_t,
+                                                T>>>;
+      const auto wide = static_cast<wide_t>(value);
+      buffer_.append(reinterpret_cast<const char *>(&wide), sizeof(wide));
+    }
+  }
+};
+
+} // namespace nutsloop::nlog
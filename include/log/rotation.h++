@@ -0,0 +1,130 @@
+#pragma once
+
+#include "types.h++"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+namespace nutsloop::nlog {
+
+using namespace nlog::types;
+
+/**
+ * Rotates the file of a log while it is being written.
+ *
+ * The bytes written are counted by whoever writes (`record` or
+ * `async_writer`), so the file system is never asked for the size of the
+ * file. When the file is due, the writing thread only renames it aside and
+ * opens a new one; shifting the generations and compressing the rotated file
+ * are left to a background thread shared by every log.
+ *
+ * One `rotation` is created by `log::set()` for every log whose
+ * `log_settings_t::get_rotation().enabled()` is true and it lives in `log_t`.
+ */
+class rotation {
+public:
+  /**
+   * @param log the log, its sink must be open on `path`.
+   * @param path the path of the log file.
+   * @param settings when to rotate and what to keep.
+   * @param size the size of the file when it has been opened.
+   */
+  rotation(log_t &log, std::filesystem::path path, const rotation_settings_t &settings,
+           std::uint64_t size);
+
+  rotation(const rotation &) = delete;
+  rotation &operator=(const rotation &) = delete;
+
+  /**
+   * Accounts for `bytes` just written, rotating the file if it is due.
+   *
+   * @note must be called with `log_t::io_mtx` held.
+   */
+  void written(std::size_t bytes);
+
+  /**
+   * Blocks until every rotated file has been moved to its generation and
+   * compressed.
+   */
+  static void wait();
+  /**
+   * Builds the background thread's state ahead of the first rotation, so
+   * that it outlives whatever is registered with `std::atexit()` afterwards.
+   * The thread itself is only started by the first rotation.
+   */
+  static void prepare();
+
+private:
+  log_t &log_;
+  const std::filesystem::path path_;
+  const rotation_settings_t settings_;
+  std::uint64_t bytes_;
+  std::chrono::steady_clock::time_point deadline_;
+
+  /**
+   * A rotated file waiting for the background thread.
+   */
+  struct job_t {
+    std::filesystem::path pending;
+    std::filesystem::path path;
+    std::size_t generations;
+    compression_t compression;
+  };
+
+  /**
+   * The background thread, started by the first rotation and joined at exit
+   * once every job is done.
+   */
+  class worker_t {
+  public:
+    worker_t() = default;
+    ~worker_t();
+
+    worker_t(const worker_t &) = delete;
+    worker_t &operator=(const worker_t &) = delete;
+
+    void post(job_t &&job);
+    void wait();
+
+  private:
+    std::mutex mtx_;
+    std::condition_variable jobs_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<job_t> jobs_;
+    bool busy_{false};
+    bool stopping_{false};
+    // HINT: started by the first post(), under `mtx_`.
+    std::thread thread_;
+
+    void run_();
+  };
+
+  static worker_t &worker_();
+
+  void rotate_();
+  /**
+   * Starts counting again, once `rotate_()` has opened a new file.
+   */
+  void reset_();
+  /**
+   * Moves `job.pending` to `<path>.1`, shifting the older generations, then
+   * compresses it.
+   */
+  static void shift_(const job_t &job);
+  /**
+   * Compresses `source` into `destination`.
+   *
+   * @return false if the codec is not available or compression failed, the
+   * source is left in place.
+   */
+  static bool compress_(const std::filesystem::path &source,
+                        const std::filesystem::path &destination, compression_t compression);
+  static const char *extension_(compression_t compression);
+};
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "types.h++"
+#include "util/level.h++"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace nutsloop::nlog {
+
+using namespace nlog::types;
+
+/**
+ * The output of a log.
+ *
+ * A sink receives complete records, one at a time from `record` or in batches
+ * from `async_writer`, and decides with its `flush_policy_t` when they are
+ * handed to the kernel. Every call is made with `log_t::io_mtx` held, a sink
+ * is never used by two threads at once.
+ *
+ * One sink is created by `log::set()` with `make_sink()` and it lives in
+ * `log_t`.
+ */
+class sink {
+public:
+  explicit sink(const flush_policy_t &policy);
+  virtual ~sink() = default;
+
+  sink(const sink &) = delete;
+  sink &operator=(const sink &) = delete;
+
+  /**
+   * Opens the file at `path`, appending to it unless `truncate` is true.
+   *
+   * @return false if the file could not be opened, see `error()`.
+   */
+  virtual bool open(const std::filesystem::path &path, bool truncate) = 0;
+  /**
+   * Flushes and closes the file.
+   */
+  virtual void close() = 0;
+  [[nodiscard]] virtual bool is_open() const = 0;
+
+  /**
+   * Writes one record, or a batch of records, flushing if the policy says so.
+   * Records written while the sink is closed are discarded.
+   *
+   * A write the file refuses (a full disk, an I/O error) loses its records,
+   * there is nowhere else to write them: the sink keeps the error, see
+   * `error()`, and carries on with the next records. A sink that cannot
+   * write at all any more closes itself.
+   *
+   * @param data complete records, newlines included.
+   * @param level the level of the record, `ERROR` if a batch holds any.
+   * @param records how many records `data` holds, for the counters.
+   */
+  void write(std::string_view data, Level level, std::size_t records = 1);
+  /**
+   * Hands every buffered record to the kernel.
+   */
+  void flush();
+  /**
+   * Flushes, then waits until every record written is durable.
+   */
+  void sync();
+
+  /**
+   * The last error of the sink, empty if none happened.
+   */
+  [[nodiscard]] const std::string &error() const { return error_; }
+
+  /**
+   * The records, bytes, flushes and write time of the sink so far, the other
+   * counters are left to the log.
+   */
+  [[nodiscard]] virtual counters_t counters() const;
+
+  /**
+   * Finds where the records of a file end, given all of its bytes.
+   */
+  using end_fn = std::size_t (*)(std::string_view file);
+  /**
+   * How a sink growing its file ahead of the records (`MMAP`) finds their end
+   * when it opens the file again, by default at the last byte that is not
+   * zero. The other sinks append and never ask.
+   */
+  void set_end(const end_fn end) { end_ = end; }
+
+protected:
+  std::string error_;
+  end_fn end_{nullptr};
+
+  virtual void write_(std::string_view data) = 0;
+  virtual void flush_() = 0;
+  virtual void sync_() = 0;
+  /**
+   * Records the last `errno` as the error of the sink.
+   */
+  void set_error_(std::string_view what);
+
+  /**
+   * Adds the time between its construction and its destruction to the write
+   * time of the sink, it wraps the system calls writing or syncing the file.
+   */
+  class syscall_timer_t {
+  public:
+    explicit syscall_timer_t(sink &owner)
+        : owner_{owner}, start_{std::chrono::steady_clock::now()} {}
+    ~syscall_timer_t() {
+      add_(owner_.write_ns_, static_cast<std::uint64_t>(
+                                 std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - start_)
+                                     .count()));
+    }
+
+    syscall_timer_t(const syscall_timer_t &) = delete;
+    syscall_timer_t &operator=(const syscall_timer_t &) = delete;
+
+  private:
+    sink &owner_;
+    const std::chrono::steady_clock::time_point start_;
+  };
+
+private:
+  const flush_policy_t policy_;
+  std::size_t pending_{0};
+  std::chrono::steady_clock::time_point flushed_at_;
+
+  std::atomic<std::uint64_t> records_{0};
+  std::atomic<std::uint64_t> bytes_{0};
+  std::atomic<std::uint64_t> flushes_{0};
+  std::atomic<std::uint64_t> write_ns_{0};
+
+  // HINT: the counters are only written with log_t::io_mtx held, a relaxed
+  //  load and store keep the locked instruction off the write path.
+  static void add_(std::atomic<std::uint64_t> &counter, const std::uint64_t value) {
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+  }
+};
+
+/**
+ * Creates the sink described by `settings`, falling back to `POSIX` when
+ * `IO_URING` is not available.
+ */
+std::shared_ptr<sink> make_sink(const sink_settings_t &settings);
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,69 @@
+#pragma once
+
+// HINT: only built when CMake finds liburing, see make_sink().
+#ifdef NLOG_HAVE_LIBURING
+
+#include "log/sink.h++"
+
+#include <array>
+#include <memory>
+
+#include <liburing.h>
+
+namespace nutsloop::nlog {
+
+/**
+ * A sink writing its buffer with io_uring.
+ *
+ * Two buffers take turns: one is being written by the kernel while records
+ * are copied into the other, so flushing does not wait for the disk. At most
+ * one write is in flight, which keeps the records in order.
+ */
+class uring_sink final : public sink {
+public:
+  explicit uring_sink(const sink_settings_t &settings);
+  ~uring_sink() override;
+
+  /**
+   * Whether the kernel accepted the ring, `make_sink()` falls back to a
+   * `posix_sink` otherwise.
+   */
+  [[nodiscard]] bool supported() const { return supported_; }
+
+  bool open(const std::filesystem::path &path, bool truncate) override;
+  void close() override;
+  [[nodiscard]] bool is_open() const override { return fd_ >= 0; }
+
+protected:
+  void write_(std::string_view data) override;
+  /**
+   * Submits the current buffer and switches to the other one.
+   */
+  void flush_() override;
+  void sync_() override;
+
+private:
+  int fd_{-1};
+  io_uring ring_{};
+  bool supported_{false};
+  const std::size_t capacity_;
+  std::array<std::unique_ptr<char[]>, 2> buffers_;
+  std::size_t current_{0};
+  std::size_t size_{0};
+  // HINT: the size of the write in flight, 0 if none.
+  std::size_t in_flight_{0};
+
+  /**
+   * Waits for the write in flight, completing it synchronously if the kernel
+   * wrote it partially or failed it.
+   */
+  void wait_();
+  /**
+   * Writes `size` bytes of `data` with plain `write` calls.
+   */
+  void write_all_(const char *data, std::size_t size);
+};
+
+} // namespace nutsloop::nlog
+
+#endif
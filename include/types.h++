@@ -1,17 +1,150 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
 
+#include "util/level.h++"
+
+namespace nutsloop::nlog {
+class async_writer;
+class rotation;
+class sink;
+}
+
 namespace nutsloop::nlog::types {
 
 const std::filesystem::path nutsloop_dir =
     std::filesystem::path(std::getenv("HOME")) / ".nutsloop";
 const std::filesystem::path nutsloop_logs_directory = nutsloop_dir / "logs";
 
+/**
+ * What an asynchronous log does with a record when its queue is full.
+ *
+ * - `BLOCK` the calling thread yields until the writer thread makes room.
+ * - `DROP_NEWEST` the record being pushed is discarded.
+ * - `DROP_OLDEST` the oldest queued record is discarded to make room.
+ *
+ * Every discarded record is counted, see `log::dropped()`.
+ */
+enum class overflow_policy_t { BLOCK, DROP_NEWEST, DROP_OLDEST };
+
+struct async_settings_t {
+  // HINT: when false the log writes on the calling thread (default).
+  bool enabled{false};
+  // number of queued records, rounded up to the next power of two.
+  std::size_t capacity{8192};
+  overflow_policy_t overflow{overflow_policy_t::BLOCK};
+};
+
+/**
+ * How rotated files are compressed, by a background thread.
+ *
+ * A codec the library has been built without (see `NLOG_HAVE_ZLIB` and
+ * `NLOG_HAVE_ZSTD`) leaves the rotated files uncompressed.
+ */
+enum class compression_t { NONE, GZIP, ZSTD };
+
+/**
+ * When the log file is rotated, while it is being written.
+ *
+ * A rotated file becomes `<file>.1`, the previous `<file>.1` becomes
+ * `<file>.2` and so on, up to `generations` files; older ones are removed.
+ * Rotation is disabled when both `max_size` and `interval` are zero (default).
+ */
+struct rotation_settings_t {
+  // HINT: bytes written to the file before it is rotated, 0 disables it.
+  std::uint64_t max_size{0};
+  // HINT: time the file is written before it is rotated, 0 disables it.
+  std::chrono::seconds interval{0};
+  // number of rotated files kept, 0 removes a file as soon as it is rotated.
+  std::size_t generations{5};
+  compression_t compression{compression_t::NONE};
+
+  [[nodiscard]] bool enabled() const { return max_size > 0 || interval.count() > 0; }
+};
+
+/**
+ * Where the records of a log end up.
+ *
+ * - `OSTREAM` a `std::ofstream` (default).
+ * - `POSIX` a file descriptor behind a large buffer, a full buffer and the
+ *   record overflowing it are written together with `writev`.
+ * - `IO_URING` like `POSIX`, buffers are written by io_uring while the next one
+ *   fills up. It falls back to `POSIX` when the kernel or the build (see
+ *   `NLOG_HAVE_LIBURING`) does not support it.
+ * - `MMAP` records are copied into a pre-allocated file mapped in memory, a
+ *   crash of the program still leaves every record written readable.
+ */
+enum class sink_type_t { OSTREAM, POSIX, IO_URING, MMAP };
+
+/**
+ * When a sink hands its buffered records to the kernel. Any condition met
+ * flushes, `log::flush()` always does and makes the records durable too.
+ */
+struct flush_policy_t {
+  // HINT: bytes buffered before flushing, 0 flushes every record (default).
+  std::size_t size{0};
+  // HINT: time since the last flush, 0 disables it. Best effort, it is only
+  //  checked when a record is written: once a synchronous log goes quiet,
+  //  what it buffers waits for the next record, `log::flush()` or
+  //  `log::close()`.
+  std::chrono::milliseconds interval{0};
+  // HINT: an ERROR record is flushed at once, along with what precedes it.
+  bool on_error{true};
+};
+
+struct sink_settings_t {
+  sink_type_t type{sink_type_t::OSTREAM};
+  // bytes buffered by the `POSIX` and `IO_URING` sinks.
+  std::size_t buffer_size{256 * 1024};
+  // bytes the `MMAP` sink grows its file by.
+  std::size_t segment_size{16 * 1024 * 1024};
+  flush_policy_t flush{};
+};
+
+/**
+ * What a log has written so far, see `log::counters()`.
+ *
+ * The counters are kept by the writing paths at the cost of a few relaxed
+ * atomic operations per record, a snapshot can be taken at any time from any
+ * thread.
+ */
+struct counters_t {
+  // HINT: records handed to the sink, and bytes including the session header
+  //  and the declaration frames of a binary log.
+  std::uint64_t records{0};
+  std::uint64_t bytes{0};
+  // HINT: times the sink was flushed with records pending, see `flush_policy_t`.
+  std::uint64_t flushes{0};
+  // HINT: time spent in the system calls writing and syncing the file.
+  std::chrono::nanoseconds write_time{0};
+  // HINT: records discarded by an asynchronous log, see `log::dropped()`.
+  std::uint64_t dropped{0};
+  // HINT: the most records ever waiting in the queue of an asynchronous log.
+  std::uint64_t queue_high_water{0};
+};
+
+/**
+ * How records are written to the file.
+ *
+ * - `TEXT` one line of text per record (default).
+ * - `BINARY` a frame per record carrying the time, the thread, the call site
+ *   and the level in binary, and the arguments of the format as typed fields
+ *   instead of the formatted text. Call sites and format strings are written
+ *   once, the file is read back with the `nlog-decode` tool. See
+ *   `log/binary.h++` for the layout.
+ */
+enum class encoding_t { TEXT, BINARY };
+
 struct log_settings_t {
 
   log_settings_t() = default;
@@ -45,6 +178,22 @@ struct log_settings_t {
     return session_header_;
   }
 
+  [[nodiscard]] async_settings_t get_async() const { return async_; }
+  void set_async(const async_settings_t &async) { async_ = async; }
+
+  // HINT: the initial minimum level, see `log::set_level()`.
+  [[nodiscard]] Level get_level() const { return level_; }
+  void set_level(const Level level) { level_ = level; }
+
+  [[nodiscard]] sink_settings_t get_sink() const { return sink_; }
+  void set_sink(const sink_settings_t &sink) { sink_ = sink; }
+
+  [[nodiscard]] rotation_settings_t get_rotation() const { return rotation_; }
+  void set_rotation(const rotation_settings_t &rotation) { rotation_ = rotation; }
+
+  [[nodiscard]] encoding_t get_encoding() const { return encoding_; }
+  void set_encoding(const encoding_t encoding) { encoding_ = encoding; }
+
   [[nodiscard]] std::filesystem::path absolute_path() {
     if (absolute_path_.empty()) {
       if (directory_.has_value()) {
@@ -63,6 +212,11 @@ private:
   std::optional<std::filesystem::path> directory_;
   std::optional<std::string> session_header_;
   std::filesystem::path absolute_path_{};
+  async_settings_t async_{};
+  Level level_{INFO};
+  sink_settings_t sink_{};
+  rotation_settings_t rotation_{};
+  encoding_t encoding_{encoding_t::TEXT};
 
   void determine_directory_absolute_path_() {
 
@@ -74,21 +228,76 @@ private:
   }
 };
 
+/**
+ * A stable reference to a log, returned by `log::set()`.
+ *
+ * It indexes a fixed-size table, logging through a handle involves neither
+ * hashing nor string comparisons.
+ */
+struct handle_t {
+  std::uint32_t index;
+};
+
 struct log_t {
 
+  // HINT: the bits of the state word, a log can be written when all are set.
+  enum state_t : std::uint32_t {
+    ACTIVE = 1U << 0,
+    RUNNING = 1U << 1,
+    OPEN = 1U << 2,
+    WRITABLE = ACTIVE | RUNNING | OPEN,
+  };
+
   log_settings_t settings;
-  std::ofstream stream;
+  // HINT: created by `log::set()` from `settings.get_sink()`.
+  std::shared_ptr<nlog::sink> sink{nullptr};
+  // HINT: held by whoever writes to, flushes or closes `sink`.
+  std::mutex io_mtx;
+  // HINT: only set when `settings.get_rotation().enabled()` is true.
+  std::shared_ptr<nlog::rotation> rotation{nullptr};
+  // HINT: only set when `settings.get_async().enabled` is true, never reset
+  //  once set, `log::close()` only stops it. Declared after `rotation`, its
+  //  thread is joined before the rotation it writes through is destroyed.
+  std::shared_ptr<nlog::async_writer> writer{nullptr};
+
+  // HINT: the index of the log in the handle table, see `log::set()`.
+  std::uint32_t handle{};
 
   log_t() = default;
   explicit log_t(log_settings_t settings)
-      : settings{std::move(settings)}, stream{std::ofstream()},
-        running_{settings.get_active()} {}
+      : settings{std::move(settings)},
+        state_{this->settings.get_active() ? ACTIVE | RUNNING : 0U} {}
+
+  bool is_running() const { return (state_.load(std::memory_order_acquire) & RUNNING) != 0; }
+  void set_running(const bool running) { set_state_(RUNNING, running); }
+
+  bool is_active() const { return (state_.load(std::memory_order_acquire) & ACTIVE) != 0; }
+  void set_active(const bool active) {
+    settings.set_active(active);
+    set_state_(ACTIVE, active);
+  }
+
+  bool is_open() const { return (state_.load(std::memory_order_acquire) & OPEN) != 0; }
+  void set_open(const bool open) { set_state_(OPEN, open); }
+
+  /**
+   * Whether the log is active, running and its file open, with a single
+   * atomic load.
+   */
+  bool is_writable() const {
+    return (state_.load(std::memory_order_acquire) & WRITABLE) == WRITABLE;
+  }
 
-  bool is_running() const { return running_; }
-  void set_running(const bool running) { running_ = running; }
 private:
-  bool running_{};
+  std::atomic<std::uint32_t> state_{};
 
+  void set_state_(const state_t bit, const bool on) {
+    if (on) {
+      state_.fetch_or(bit, std::memory_order_acq_rel);
+    } else {
+      state_.fetch_and(~static_cast<std::uint32_t>(bit), std::memory_order_acq_rel);
+    }
+  }
 };
 
 using log_registry_t = std::unordered_map<std::string, log_t>;
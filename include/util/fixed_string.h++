@@ -0,0 +1,23 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace nutsloop {
+
+/**
+ * A string literal usable as a template argument, e.g. the identifier in
+ * `log::info<"ident">(...)`.
+ */
+template <std::size_t N> struct fixed_string {
+  // NOLINTNEXTLINE(*-explicit-constructor)
+  constexpr fixed_string(const char (&string)[N]) { std::copy_n(string, N, value.begin()); }
+
+  [[nodiscard]] constexpr std::string_view view() const { return {value.data(), N - 1}; }
+
+  std::array<char, N> value{};
+};
+
+} // namespace nutsloop
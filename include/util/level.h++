@@ -2,23 +2,63 @@
 
 #include "ansi.h++"
 
+#include <array>
+#include <string>
+#include <string_view>
+
+// MARK: (LOG) minimum level pre-processor
+// HINT: the values of `Level`, usable in `#if` and on the command line,
+//  e.g. `-DNLOG_MIN_LEVEL=NLOG_LEVEL_INFO`.
+#define NLOG_LEVEL_TRACE 0
+#define NLOG_LEVEL_DEBUG 1
+#define NLOG_LEVEL_INFO 2
+#define NLOG_LEVEL_WARN 3
+#define NLOG_LEVEL_ERROR 4
+#define NLOG_LEVEL_NONE 5
+
+#ifndef NLOG_MIN_LEVEL
+// HINT: default value if not defined elsewhere
+#define NLOG_MIN_LEVEL NLOG_LEVEL_TRACE
+#endif
+
 namespace nutsloop {
 
-enum Level { INFO, WARN, ERROR, NONE };
+// HINT: ordered by severity, `NONE` records carry no tag and are never
+//  filtered.
+enum Level { TRACE, DEBUG, INFO, WARN, ERROR, NONE };
+
+static_assert(TRACE == NLOG_LEVEL_TRACE && DEBUG == NLOG_LEVEL_DEBUG && INFO == NLOG_LEVEL_INFO &&
+              WARN == NLOG_LEVEL_WARN && ERROR == NLOG_LEVEL_ERROR && NONE == NLOG_LEVEL_NONE);
+
+/**
+ * The lowest level compiled in, see `NLOG_MIN_LEVEL`.
+ *
+ * The `NLOG_<LEVEL>()` macros of lower levels expand to a discarded
+ * statement: neither the call nor its arguments are part of the program.
+ */
+constexpr Level min_level = static_cast<Level>(NLOG_MIN_LEVEL);
+
+/**
+ * Returns the colored tag of a level.
+ *
+ * The tags are built once, the first time the function is called, and every
+ * call returns a view over them.
+ */
+inline std::string_view level(const Level level) {
 
-inline std::string level(const Level level) {
+  static const std::array<std::string, 6> levels{
+      "TRACE",
+      "DEBUG"_.bold().to_string(),
+      "INFO"_.green().to_string(),
+      "WARN"_.yellow().to_string(),
+      "ERROR"_.red().to_string(),
+      "",
+  };
 
-  switch (level) {
-  case INFO:
-    return "INFO"_.green().to_string();
-  case WARN:
-    return "WARN"_.yellow().to_string();
-  case ERROR:
-    return "ERROR"_.red().to_string();
-  case NONE:
-    return "";
+  if (level < TRACE || level > NONE) {
+    return "UNKNOWN";
   }
 
-  return "UNKNOWN";
+  return levels[level];
 }
 } // namespace nutsloop
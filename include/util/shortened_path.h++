@@ -1,53 +1,101 @@
 #pragma once
+#include <array>
+#include <cstddef>
 #include <filesystem>
-#include <sstream>
+#include <string>
+#include <string_view>
 
 namespace nutsloop {
-inline std::string shortened_path(const std::filesystem::path &path) {
-  using namespace std::filesystem;
 
-  std::ostringstream shortened_path;
+/**
+ * A path shortened by `shorten_path()`, stored inline so that it can be
+ * computed at compile time.
+ */
+struct shortened_path_t {
+  std::array<char, 512> data{};
+  std::size_t size{0};
+
+  [[nodiscard]] constexpr std::string_view view() const { return {data.data(), size}; }
 
-  // Convert to an absolute path if needed and check existence
-  std::filesystem::path abs_path =
-      path.is_absolute() ? path : current_path() / path;
-  if (!exists(abs_path)) {
-    throw filesystem_error("Path does not exist", abs_path, std::error_code());
+  constexpr void append(const std::string_view string) {
+    for (const char character : string) {
+      if (size == data.size()) {
+        return;
+      }
+      data[size++] = character;
+    }
   }
+};
+
+/**
+ * Shortens a path, keeping the last two segments and abbreviating the others
+ * to their first character (two characters when the first one is not
+ * alphanumeric, e.g. `.config` -> `.c`).
+ *
+ * `/home/user/projects/log/src/log/stream.c++` -> `/h/u/p/l/s/log/stream.c++`
+ *
+ * The path is processed lexically: the file system is never touched, which
+ * makes it usable with `__FILE__` on hosts without the sources, and in
+ * constant expressions.
+ */
+constexpr shortened_path_t shorten_path(const std::string_view path) {
+
+  shortened_path_t shortened;
 
   // Preserve the leading separator for absolute paths
-  if (abs_path.is_absolute()) {
-    shortened_path << '/';
+  if (path.starts_with('/')) {
+    shortened.append("/");
   }
 
-  // Collect segments for processing
-  std::vector<std::filesystem::path> segments;
-  for (const auto &segment : abs_path) {
-    if (!segment.empty() && segment != "/") {
-      segments.push_back(segment);
+  // Count the segments, so the last two are known while walking them
+  std::size_t count = 0;
+  for (std::size_t begin = 0; begin < path.size();) {
+    std::size_t end = path.find('/', begin);
+    if (end == std::string_view::npos) {
+      end = path.size();
     }
+    if (end > begin) {
+      ++count;
+    }
+    begin = end + 1;
   }
 
   // Handle each segment based on position
-  for (size_t i = 0; i < segments.size(); ++i) {
-    const std::string segment_str = segments[i].string();
-
-    if (i == segments.size() - 2 || i == segments.size() - 1) {
-      // Second-to-last and last segments: include fully
-      shortened_path << segment_str;
-      if (i == segments.size() - 2) {
-        shortened_path << "/";
-      }
-    } else {
-      // Other segments: shorten
-      if (!isalnum(segment_str[0])) {
-        shortened_path << segment_str.substr(0, 2) << "/";
+  std::size_t i = 0;
+  for (std::size_t begin = 0; begin < path.size();) {
+    std::size_t end = path.find('/', begin);
+    if (end == std::string_view::npos) {
+      end = path.size();
+    }
+    if (end > begin) {
+      const std::string_view segment = path.substr(begin, end - begin);
+      if (i + 2 >= count) {
+        // Second-to-last and last segments: include fully
+        shortened.append(segment);
+        if (i + 2 == count) {
+          shortened.append("/");
+        }
       } else {
-        shortened_path << segment_str[0] << "/";
+        // Other segments: shorten
+        const char first = segment[0];
+        const bool alphanumeric =
+            (first >= '0' && first <= '9') || (first >= 'a' && first <= 'z') ||
+            (first >= 'A' && first <= 'Z');
+        shortened.append(segment.substr(0, alphanumeric ? 1 : 2));
+        shortened.append("/");
       }
+      ++i;
     }
+    begin = end + 1;
   }
 
-  return shortened_path.str();
+  return shortened;
+}
+
+inline std::string shortened_path(const std::filesystem::path &path) {
+  // Convert to an absolute path if needed
+  const std::filesystem::path abs_path =
+      path.is_absolute() ? path : std::filesystem::current_path() / path;
+  return std::string(shorten_path(abs_path.native()).view());
 }
 } // namespace nutsloop
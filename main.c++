@@ -15,9 +15,9 @@ using namespace nutsloop;
 
 #else
 
-#define LOG log::stream( "log", __FILE__, __LINE__, nutsloop::Level::INFO )
-#define LOG_WARN log::stream( "log", __FILE__, __LINE__, nutsloop::Level::WARN )
-#define LOG_ERROR log::stream( "log", __FILE__, __LINE__, nutsloop::Level::ERROR )
+#define LOG log::stream( "log", NLOG_CALLSITE( nutsloop::Level::INFO ) )
+#define LOG_WARN log::stream( "log", NLOG_CALLSITE( nutsloop::Level::WARN ) )
+#define LOG_ERROR log::stream( "log", NLOG_CALLSITE( nutsloop::Level::ERROR ) )
 
 #endif
 
@@ -43,10 +43,10 @@ int main() {
     std::nullopt,
     std::nullopt
   );
-  log::set( llog_settings );
+  const handle_t llog_handle = log::set( llog_settings );
   log::activate();
 
-  const auto llog_instance = log::get_instance( llog_settings.get_ident() );
+  const auto llog_instance = log::get_instance( llog_handle );
   log::stream( "log", "", *"", nutsloop::Level::WARN ) << '\n'
     << llog_instance->ident() << '\n';
   llog_instance->ostream() << "llog_ostream >> Hello World!" << '\n';
@@ -59,6 +59,19 @@ int main() {
   LOG_WARN << "Hello World!" << '\n';
   LOG_ERROR << "Hello World!" << '\n';
 
+  // format strings are checked at compile time, the location is implicit.
+  log::info<"log">( "Hello {}! {} + {} = {}", "World", 1, 1.5, 1 + 1.5 );
+  log::warn<"log">( "ident -> {}", llog_instance->ident() );
+  // through the handle, no lookup by identifier.
+  log::info( llog_handle, "handle -> {}", llog_handle.index );
+  llog_instance->error( "instance -> {}", llog_instance->ident() );
+
+  // TRACE and DEBUG are off by default, the arguments are not even evaluated.
+  NLOG_DEBUG( llog_handle ) << "not logged " << llog_instance->ident() << '\n';
+  log::set_level( llog_handle, nutsloop::Level::TRACE );
+  NLOG_DEBUG( llog_handle ) << "logged " << llog_instance->ident() << '\n';
+  NLOG_TRACEF( llog_handle, "level -> {}", static_cast<int>( llog_instance->level() ) );
+
   // Set the log settings again to test the log::set() function
   // the internal_debug should show a WARN log message.
   log::set(llog_settings);
@@ -11,10 +11,12 @@ std::atomic<bool> log::set_has_been_called_{false};
 std::atomic<bool> log::activated_{false};
 
 std::unique_ptr<log_registry_t> log::log_registry_{nullptr};
-std::unique_ptr<log_t> log::log_{nullptr};
+
+std::array<std::atomic<log_t *>, LOG_MAX_HANDLES> log::handles_{};
+std::atomic<std::uint32_t> log::handles_size_{0};
+std::array<std::atomic<Level>, LOG_MAX_HANDLES> log::levels_{};
 
 std::unique_ptr<log::stream_redirect_> log::stream_redirect_pointer_{nullptr};
 std::atomic<bool> log::stream_redirect_active_{false};
-log::null_logger_ log::null_log_;
 
 } // namespace nutsloop
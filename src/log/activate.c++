@@ -26,21 +26,8 @@ void log::activate() {
   }
 #endif
 
-  if (log_registry_ == nullptr) {
-    log_registry_ = std::make_unique<log_registry_t>();
-
-#if DEBUG_LOG == true
-    {
-      std::shared_lock lock{mtx_};
-      const auto log_registry_address =
-          reinterpret_cast<uintptr_t>(&log_registry_);
-      internal_debug_->stream(__FILE__, __LINE__, INFO)
-          << "log_registry_ is nullptr, creating..." << '\n'
-          << std::format("pointer with address -> 0x{:x}", log_registry_address)
-          << std::endl;
-    }
-#endif
-  }
+  // HINT: created by log::set() already, only set_log_registry_() creates it.
+  set_log_registry_();
 }
 
 } // namespace nutsloop
@@ -0,0 +1,13 @@
+#include "log/async_writer.h++"
+
+namespace nutsloop::nlog {
+
+async_writer::async_writer(sink &sink, std::mutex &io_mtx, const async_settings_t &settings,
+                           rotation *rotation /*= nullptr*/)
+    : sink_{sink}, io_mtx_{io_mtx}, rotation_{rotation}, overflow_{settings.overflow},
+      queue_{settings.capacity},
+      thread_{&async_writer::run_, this} {}
+
+async_writer::~async_writer() { stop(); }
+
+} // namespace nutsloop::nlog
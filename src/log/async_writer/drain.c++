@@ -0,0 +1,20 @@
+#include "log/async_writer.h++"
+
+namespace nutsloop::nlog {
+
+void async_writer::drain() {
+
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  const std::uint64_t target = pushed_.load(std::memory_order_acquire);
+  std::uint64_t consumed = consumed_.load(std::memory_order_acquire);
+  while (consumed < target) {
+    wake_up_(true);
+    consumed_.wait(consumed, std::memory_order_acquire);
+    consumed = consumed_.load(std::memory_order_acquire);
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,79 @@
+#include "log/async_writer.h++"
+
+#include <cstring>
+
+namespace nutsloop::nlog {
+
+void async_writer::push(const std::string_view record, const render_fn render /*= nullptr*/,
+                        const Level level /*= NONE*/) {
+
+  push(
+      record.size(),
+      [](char *out, const void *context) {
+        const auto *bytes = static_cast<const std::string_view *>(context);
+        std::memcpy(out, bytes->data(), bytes->size());
+      },
+      &record, render, level);
+}
+
+void async_writer::push(const std::size_t size, const encode_fn encode, const void *context,
+                        const render_fn render, const Level level) {
+
+  // HINT: pairs with stop(), either stop() waits for this push or this push
+  //  sees stopping_, a record is never queued once the writer may be gone.
+  producers_.fetch_add(1, std::memory_order_seq_cst);
+  if (stopping_.load(std::memory_order_seq_cst)) {
+    producers_.fetch_sub(1, std::memory_order_release);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // HINT: the claimed cell is published whatever happens, a record that
+  //  cannot be copied in (a long one, when memory runs out) is queued as
+  //  failed, the writer thread drops it.
+  const auto fill = [&](entry_t &entry) noexcept {
+    try {
+      encode(entry.reserve(size), context);
+      entry.failed = false;
+    } catch (...) {
+      entry.size = 0;
+      entry.failed = true;
+    }
+    entry.render = render;
+    entry.level = level;
+  };
+
+  switch (overflow_) {
+  case overflow_policy_t::BLOCK:
+    // the writer thread keeps popping until every producer is out.
+    while (!queue_.try_emplace(fill)) {
+      wake_up_();
+      std::this_thread::yield();
+    }
+    break;
+  case overflow_policy_t::DROP_NEWEST:
+    if (!queue_.try_emplace(fill)) {
+      producers_.fetch_sub(1, std::memory_order_release);
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    break;
+  case overflow_policy_t::DROP_OLDEST:
+    while (!queue_.try_emplace(fill)) {
+      if (queue_.try_consume([](entry_t &) {})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        consumed_.fetch_add(1, std::memory_order_release);
+      }
+    }
+    break;
+  }
+
+  pushed_.fetch_add(1, std::memory_order_release);
+  // HINT: pairs with the fence in run_(), either the writer sees the record
+  //  or this thread sees the writer asleep.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  wake_up_();
+  producers_.fetch_sub(1, std::memory_order_release);
+}
+
+} // namespace nutsloop::nlog
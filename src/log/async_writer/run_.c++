@@ -0,0 +1,109 @@
+#include "log/async_writer.h++"
+
+#include "log/rotation.h++"
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+void async_writer::run_() {
+
+  std::string batch;
+  batch.reserve(batch_size_);
+  // HINT: whether the sink may hold records of the batches written so far.
+  bool unflushed = false;
+
+  std::uint64_t popped = 0;
+  // HINT: the records popped that could not be copied in or rendered, they
+  //  are counted as dropped instead of written.
+  std::uint64_t lost = 0;
+  Level level = NONE;
+  // HINT: reads the record out of its cell, nothing is moved or freed.
+  const auto consume = [&](entry_t &entry) {
+    ++popped;
+    if (entry.failed) {
+      ++lost;
+      return;
+    }
+    // deferred records are formatted here, off the logging threads.
+    // HINT: a record failing to render (e.g. std::bad_alloc) is dropped,
+    //  whatever part of it made it into the batch is taken out again.
+    const std::size_t mark = batch.size();
+    try {
+      if (entry.render != nullptr) {
+        entry.render(entry.view(), batch);
+      } else {
+        batch.append(entry.view());
+      }
+    } catch (...) {
+      batch.resize(mark);
+      ++lost;
+      return;
+    }
+    if (entry.level == ERROR) {
+      level = ERROR;
+    }
+  };
+
+  for (;;) {
+
+    // HINT: sampled once per batch by the only thread writing high_water_,
+    //  the push path stays free of it. Approximate, a record may be queued
+    //  before it is counted as pushed.
+    const std::uint64_t pushed = pushed_.load(std::memory_order_relaxed);
+    const std::uint64_t consumed = consumed_.load(std::memory_order_relaxed);
+    if (pushed > consumed && pushed - consumed > high_water_.load(std::memory_order_relaxed)) {
+      high_water_.store(pushed - consumed, std::memory_order_relaxed);
+    }
+
+    popped = 0;
+    lost = 0;
+    level = NONE;
+    while (batch.size() < batch_size_ && queue_.try_consume(consume)) {
+    }
+
+    if (popped > 0) {
+      { // MARK (async_writer) MUTEX LOCK
+        std::lock_guard lock(io_mtx_);
+        sink_.write(batch, level, popped - lost);
+        if (rotation_ != nullptr) {
+          rotation_->written(batch.size());
+        }
+      }
+      batch.clear();
+      unflushed = true;
+      dropped_.fetch_add(lost, std::memory_order_relaxed);
+      consumed_.fetch_add(popped, std::memory_order_release);
+      consumed_.notify_all();
+      continue;
+    }
+
+    // the queue is empty, whatever the flush policy the sink hands its
+    // records to the kernel before the writer goes to sleep.
+    if (unflushed) {
+      std::lock_guard lock(io_mtx_);
+      sink_.flush();
+      unflushed = false;
+    }
+
+    // let drain() know before going to sleep.
+    consumed_.notify_all();
+    // HINT: records pushed between the last pop and closed_ are seen here.
+    if (closed_.load(std::memory_order_acquire)) {
+      if (queue_.empty()) {
+        return;
+      }
+      continue;
+    }
+
+    const std::uint32_t ticket = wake_.load(std::memory_order_acquire);
+    sleeping_.store(true, std::memory_order_relaxed);
+    // HINT: pairs with the fence in push().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (queue_.empty() && !closed_.load(std::memory_order_acquire)) {
+      wake_.wait(ticket, std::memory_order_acquire);
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,28 @@
+#include "log/async_writer.h++"
+
+namespace nutsloop::nlog {
+
+void async_writer::stop() {
+
+  // stopped already, by log::close() before the destructor.
+  if (stopping_.exchange(true, std::memory_order_seq_cst)) {
+    return;
+  }
+
+  // HINT: pushes that got past stopping_ still queue their record, the writer
+  //  thread keeps popping (a BLOCK producer may be waiting for room) until
+  //  the last one is out.
+  while (producers_.load(std::memory_order_acquire) != 0) {
+    wake_up_(true);
+    std::this_thread::yield();
+  }
+
+  // the writer thread empties the queue before looking at closed_.
+  closed_.store(true, std::memory_order_release);
+  wake_up_(true);
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,13 @@
+#include "log/async_writer.h++"
+
+namespace nutsloop::nlog {
+
+void async_writer::wake_up_(const bool force /*= false*/) {
+
+  if (force || sleeping_.load(std::memory_order_relaxed)) {
+    wake_.fetch_add(1, std::memory_order_release);
+    wake_.notify_one();
+  }
+}
+
+} // namespace nutsloop::nlog
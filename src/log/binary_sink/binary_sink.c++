@@ -0,0 +1,19 @@
+#include "log/binary_sink.h++"
+
+#include <limits>
+
+namespace nutsloop::nlog {
+
+// HINT: its own policy never flushes, the wrapped sink decides.
+binary_sink::binary_sink(std::shared_ptr<sink> inner)
+    : sink{flush_policy_t{.size = std::numeric_limits<std::size_t>::max(),
+                          .interval = std::chrono::milliseconds{0},
+                          .on_error = false}},
+      inner_{std::move(inner)} {
+  // HINT: frames may end with zeroes, trimming them would cut the last one.
+  inner_->set_end(&binary::end_of);
+}
+
+binary_sink::~binary_sink() { binary_sink::close(); }
+
+} // namespace nutsloop::nlog
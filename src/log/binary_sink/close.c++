@@ -0,0 +1,7 @@
+#include "log/binary_sink.h++"
+
+namespace nutsloop::nlog {
+
+void binary_sink::close() { inner_->close(); }
+
+} // namespace nutsloop::nlog
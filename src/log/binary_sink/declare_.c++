@@ -0,0 +1,47 @@
+#include "log/binary_sink.h++"
+
+#include "log/callsite.h++"
+
+#include <cstring>
+
+namespace nutsloop::nlog {
+
+void binary_sink::declare_(const binary::record_header_t &header) {
+
+  // HINT: ids are addresses of call sites and format strings, which live as
+  //  long as the program.
+  if (header.site != 0 && sites_.insert(header.site).second) {
+    const auto *site = reinterpret_cast<const callsite_t *>(header.site);
+    const std::size_t file_size = std::strlen(site->file);
+    const std::size_t body_size =
+        sizeof(std::uint64_t) + sizeof(std::uint8_t) + sizeof(std::uint32_t) + file_size;
+
+    const std::size_t start = frames_.size();
+    frames_.resize(start + binary::frame_header_size + body_size);
+    char *cursor = frames_.data() + start;
+    binary::store(cursor, binary::frame_t::CALLSITE);
+    binary::store(cursor, static_cast<std::uint32_t>(body_size));
+    binary::store(cursor, header.site);
+    binary::store(cursor, static_cast<std::uint8_t>(site->level));
+    binary::store(cursor, static_cast<std::uint32_t>(site->line));
+    std::memcpy(cursor, site->file, file_size);
+  }
+
+  if (header.format != 0 && formats_.insert(header.format).second) {
+    const std::size_t body_size = sizeof(std::uint64_t) + header.format_size;
+
+    const std::size_t start = frames_.size();
+    frames_.resize(start + binary::frame_header_size + body_size);
+    char *cursor = frames_.data() + start;
+    binary::store(cursor, binary::frame_t::FORMAT);
+    binary::store(cursor, static_cast<std::uint32_t>(body_size));
+    binary::store(cursor, header.format);
+    std::memcpy(cursor, reinterpret_cast<const char *>(header.format), header.format_size);
+  }
+
+  if (!frames_.empty()) {
+    emit_();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,11 @@
+#include "log/binary_sink.h++"
+
+namespace nutsloop::nlog {
+
+void binary_sink::emit_() {
+  inner_->write(frames_, NONE, 0);
+  unsynced_ += frames_.size();
+  frames_.clear();
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,10 @@
+#include "log/binary_sink.h++"
+
+namespace nutsloop::nlog {
+
+void binary_sink::flush_() {
+  inner_->flush();
+  error_ = inner_->error();
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,25 @@
+#include "log/binary_sink.h++"
+
+#include <array>
+
+namespace nutsloop::nlog {
+
+void binary_sink::mark_() {
+
+  // HINT: the time of the frame is not before any record preceding it, which
+  //  is what a reader bisecting the file relies on.
+  std::array<char, binary::sync_size> frame; // NOLINT(*-pro-type-member-init)
+  char *cursor = frame.data();
+  binary::store(cursor, binary::frame_t::SYNC);
+  binary::store(cursor, static_cast<std::uint32_t>(binary::sync_size - binary::frame_header_size));
+  binary::store(cursor, binary::sync_marker);
+  binary::store(cursor, binary::now());
+
+  frames_.append(frame.data(), frame.size());
+  emit_();
+  unsynced_ = 0;
+  sites_.clear();
+  formats_.clear();
+}
+
+} // namespace nutsloop::nlog
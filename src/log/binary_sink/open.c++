@@ -0,0 +1,30 @@
+#include "log/binary_sink.h++"
+
+#include <system_error>
+
+namespace nutsloop::nlog {
+
+bool binary_sink::open(const std::filesystem::path &path, const bool truncate) {
+
+  // HINT: asked before opening, the MMAP sink grows the file when it opens it.
+  std::error_code error;
+  const bool empty = truncate || !std::filesystem::exists(path, error) ||
+                     std::filesystem::file_size(path, error) == 0;
+
+  if (!inner_->open(path, truncate)) {
+    error_ = inner_->error();
+    return false;
+  }
+  error_.clear();
+
+  if (empty) {
+    frames_.append(binary::magic.data(), binary::magic.size());
+    frames_.append(reinterpret_cast<const char *>(&binary::version), sizeof(binary::version));
+  }
+  // the file may have been written by an earlier run, whose ids mean nothing.
+  mark_();
+  inner_->flush();
+  return true;
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,50 @@
+#include "log/binary_sink.h++"
+
+namespace nutsloop::nlog {
+
+void binary_sink::write_(const std::string_view data) {
+
+  // records already declared are forwarded in runs, as they came.
+  std::size_t run = 0;
+  std::size_t records = 0;
+  Level level = NONE;
+  const auto forward = [&](const std::size_t end) {
+    if (end > run) {
+      inner_->write(data.substr(run, end - run), level, records);
+      unsynced_ += end - run;
+      run = end;
+      records = 0;
+      level = NONE;
+    }
+  };
+
+  std::size_t offset = 0;
+  while (offset + binary::record_offset <= data.size()) {
+
+    const char *cursor = data.data() + offset;
+    if (binary::load<binary::frame_t>(cursor) != binary::frame_t::RECORD) {
+      break;
+    }
+    const std::size_t size = binary::frame_header_size + binary::load<std::uint32_t>(cursor);
+    const binary::record_header_t header = binary::load_record(data.data() + offset);
+
+    if (unsynced_ + (offset - run) >= binary::sync_interval) {
+      forward(offset);
+      mark_();
+    }
+    if ((header.site != 0 && !sites_.contains(header.site)) ||
+        (header.format != 0 && !formats_.contains(header.format))) {
+      forward(offset);
+      declare_(header);
+    }
+    if (header.level == ERROR) {
+      level = ERROR;
+    }
+    ++records;
+    offset += size;
+  }
+
+  forward(data.size());
+}
+
+} // namespace nutsloop::nlog
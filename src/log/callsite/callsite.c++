@@ -0,0 +1,130 @@
+#include "log/callsite.h++"
+
+#include "util/shortened_path.h++"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace nutsloop::nlog {
+
+namespace {
+
+// HINT: keyed by the contents of the file name, never by its address: the
+//  same address may hold another name later on.
+struct key_t {
+  std::string_view file;
+  int line;
+  Level level;
+
+  bool operator==(const key_t &) const = default;
+};
+
+struct key_hash_t {
+  std::size_t operator()(const key_t &key) const {
+    std::size_t hash = std::hash<std::string_view>{}(key.file);
+    hash ^= static_cast<std::size_t>(key.line) * 0x9e3779b97f4a7c15U;
+    hash ^= static_cast<std::size_t>(key.level) << 1;
+    return hash;
+  }
+};
+
+// HINT: owns the copy of the file name the descriptor points to.
+struct node_t {
+  std::string file;
+  callsite_t site;
+};
+
+std::string make_prefix(const std::string_view file, const int line, const Level c) {
+
+  std::string prefix = std::format("[{}] [", level(c));
+  if (!file.empty()) {
+    prefix.append(shorten_path(file).view());
+  }
+  prefix.push_back(':');
+  if (line != 0) {
+    std::format_to(std::back_inserter(prefix), "{}", line);
+  }
+  prefix.push_back(']');
+
+  return prefix;
+}
+
+const callsite_t &find_or_create(const key_t &key) {
+
+  // HINT: leaked on purpose, records still queued when the program exits
+  //  point into the registry and may be written after the function-local
+  //  statics are destroyed.
+  static auto &mtx = *new std::shared_mutex;
+  static auto &registry = *new std::unordered_map<key_t, std::unique_ptr<node_t>, key_hash_t>;
+
+  { // MARK (callsite) MUTEX LOCK
+    std::shared_lock lock(mtx);
+    if (const auto iterator = registry.find(key); iterator != registry.end()) {
+      return iterator->second->site;
+    }
+  }
+
+  { // MARK (callsite) MUTEX LOCK
+    std::unique_lock lock(mtx);
+    if (const auto iterator = registry.find(key); iterator != registry.end()) {
+      return iterator->second->site;
+    }
+    auto node = std::make_unique<node_t>(node_t{std::string{key.file}, {}});
+    node->site = callsite_t{key.level, node->file.c_str(), key.line,
+                            make_prefix(key.file, key.line, key.level)};
+    const key_t owned{node->file, key.line, key.level};
+    return registry.emplace(owned, std::move(node)).first->second->site;
+  }
+}
+
+} // namespace
+
+const callsite_t &callsite(const char *file, const int line, const Level c) {
+
+  // HINT: direct-mapped, a collision only costs a trip to the registry. The
+  //  contents are compared on every hit, the address of `file` proves nothing.
+  thread_local std::array<const callsite_t *, 256> cache{};
+
+  const key_t key{file == nullptr ? std::string_view{} : std::string_view{file}, line, c};
+  const callsite_t *&entry = cache[key_hash_t{}(key) % cache.size()];
+  if (entry == nullptr || entry->line != line || entry->level != c ||
+      std::string_view{entry->file} != key.file) {
+    entry = &find_or_create(key);
+  }
+
+  return *entry;
+}
+
+const callsite_t &static_callsite(const char *file, const int line, const Level c) {
+
+  // HINT: direct-mapped and keyed by address, which `file` having static
+  //  storage duration makes unique to its contents.
+  struct entry_t {
+    const char *file{nullptr};
+    int line{0};
+    Level level{NONE};
+    const callsite_t *site{nullptr};
+  };
+  thread_local std::array<entry_t, 256> cache{};
+
+  auto hash = reinterpret_cast<std::uintptr_t>(file);
+  hash ^= static_cast<std::uintptr_t>(line) * 0x9e3779b97f4a7c15U;
+  hash ^= static_cast<std::uintptr_t>(c) << 1;
+  entry_t &entry = cache[hash % cache.size()];
+  if (entry.site == nullptr || entry.file != file || entry.line != line || entry.level != c) {
+    entry = {file, line, c, &find_or_create({file, line, c})};
+  }
+
+  return *entry.site;
+}
+
+} // namespace nutsloop::nlog
@@ -4,7 +4,8 @@ namespace nutsloop {
 
 void log::close(const std::string &ident) {
 
-  if (!log_registry_->contains(ident)) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -29,17 +30,24 @@ void log::close(const std::string &ident) {
   }
 #endif
 
-  log_t *log_ident = &log_registry_->at(ident);
   // first, we set the log_ident->running_ to false
   if (log_ident->is_running()) {
     stop(ident);
   }
-  // then, we close the log_ident->stream
-  if (log_ident->stream.is_open()) {
-    log_ident->stream.close();
+  // then, we write whatever is still queued and join the writer thread.
+  // HINT: the writer itself lives as long as the log, threads still holding
+  //  the pointer push into a stopped writer, which drops and counts.
+  if (log_ident->writer != nullptr) {
+    log_ident->writer->stop();
+  }
+  // then, we close the log_ident->sink, it flushes whatever it buffers
+  if (std::lock_guard io_lock(log_ident->io_mtx);
+      log_ident->sink != nullptr && log_ident->sink->is_open()) {
+    log_ident->set_open(false);
+    log_ident->sink->close();
 
     // TODO: do something with this thang.
-    if (log_ident->stream.fail()) {}
+    if (!log_ident->sink->error().empty()) {}
   }
 }
 
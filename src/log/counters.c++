@@ -0,0 +1,51 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+namespace {
+
+counters_t snapshot(const log_t *log_ident) {
+
+  counters_t counters = log_ident->sink == nullptr ? counters_t{} : log_ident->sink->counters();
+  // HINT: a closed log keeps its stopped writer, and so its queue counters.
+  if (log_ident->writer != nullptr) {
+    counters.dropped = log_ident->writer->dropped();
+    counters.queue_high_water = log_ident->writer->high_water();
+  }
+  return counters;
+}
+
+} // namespace
+
+counters_t log::counters(const handle_t handle) {
+
+  const log_t *log_ident = resolve_(handle);
+  if (log_ident == nullptr) {
+    throw std::invalid_argument(std::format("log handle `{}` not found.", handle.index));
+  }
+
+  return snapshot(log_ident);
+}
+
+counters_t log::counters(const std::string &ident) {
+
+  const log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock(mtx_);
+      internal_debug_->stream(__FILE__, __LINE__, ERROR)
+          << ansi("log::counters([{}]) called ⇣", ident).red().bold() << '\n'
+          << ansi("    log identified with `{}` not found.", ident).red() << '\n'
+          << "    throw std::invalid_argument" << '\n';
+    }
+#endif
+
+    throw std::invalid_argument("log identified with `" + ident + "` not found.");
+  }
+
+  return snapshot(log_ident);
+}
+
+} // namespace nutsloop
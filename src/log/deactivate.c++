@@ -1,6 +1,7 @@
 #include "log.h++"
 
 #include <iostream>
+#include <ranges>
 
 namespace nutsloop {
 
@@ -12,6 +13,15 @@ void log::deactivate() {
   }
   [[maybe_unused]] const bool previous_activate_status = activated_.exchange(false);
 
+  // records queued before the deactivation still reach the files.
+  if (std::shared_lock lock(mtx_); log_registry_ != nullptr) {
+    for (log_t &log_ident : *log_registry_ | std::views::values) {
+      if (log_ident.writer != nullptr) {
+        log_ident.writer->drain();
+      }
+    }
+  }
+
 #if DEBUG_LOG == true
   { // MARK (LOG) MUTEX LOCK
     std::unique_lock lock(mtx_);
@@ -0,0 +1,25 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+std::uint64_t log::dropped(const std::string &ident) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock(mtx_);
+      internal_debug_->stream(__FILE__, __LINE__, ERROR)
+          << ansi("log::dropped([{}]) called ⇣", ident).red().bold() << '\n'
+          << ansi("    log identified with `{}` not found.", ident).red() << '\n'
+          << "    throw std::invalid_argument" << '\n';
+    }
+#endif
+
+    throw std::invalid_argument("log identified with `" + ident + "` not found.");
+  }
+
+  return log_ident->writer == nullptr ? 0 : log_ident->writer->dropped();
+}
+
+} // namespace nutsloop
@@ -0,0 +1,18 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+log_t *log::find_(const std::string_view ident) {
+
+  // MARK (LOG) MUTEX LOCK
+  std::shared_lock lock(mtx_);
+
+  if (log_registry_ == nullptr) {
+    return nullptr;
+  }
+
+  const auto iterator = log_registry_->find(std::string(ident));
+  return iterator == log_registry_->end() ? nullptr : &iterator->second;
+}
+
+} // namespace nutsloop
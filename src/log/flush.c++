@@ -12,7 +12,8 @@ void log::flush(const std::string &ident) {
   }
 #endif
 
-  if (!log_registry_->contains(ident)) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -27,12 +28,16 @@ void log::flush(const std::string &ident) {
   }
 
   { // MARK (LOG) MUTEX LOCK
-    log_t *log_ident = &log_registry_->at(ident);
-    std::unique_lock lock(mtx_);
-    if (log_ident->stream.is_open()) {
-      log_ident->stream.close();
+    // an asynchronous log writes its queue first.
+    if (log_ident->writer != nullptr) {
+      log_ident->writer->drain();
+    }
+    // keeps records (and the writer thread) away from the sink while it is
+    // being synced.
+    std::lock_guard io_lock(log_ident->io_mtx);
+    if (log_ident->sink != nullptr && log_ident->sink->is_open()) {
+      log_ident->sink->sync();
     }
-    log_ident->stream.open(log_ident->settings.absolute_path(), std::ios::out | std::ios::trunc);
   }
 }
 
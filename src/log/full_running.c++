@@ -15,15 +15,14 @@ bool log::full_running(const std::string &ident) {
   if (!is_activated_())
     return false;
 
-  if (log_registry_->contains(ident)) {
-    const log_t *log_ident = &log_registry_->at(ident);
-    if (log_ident->is_running() && log_ident->stream.is_open()) {
+  if (const log_t *log_ident = find_(ident); log_ident != nullptr) {
+    if (log_ident->is_running() && log_ident->is_open()) {
       return true;
     }
-    if (log_ident->is_running() && !log_ident->stream.is_open()) {
+    if (log_ident->is_running() && !log_ident->is_open()) {
       return false;
     }
-    if (!log_ident->is_running() && !log_ident->stream.is_open()) {
+    if (!log_ident->is_running() && !log_ident->is_open()) {
       return false;
     }
   }
@@ -3,7 +3,8 @@
 namespace nutsloop {
 
 std::filesystem::path log::get_absolute_path(const std::string &ident) {
-  if (!log_registry_->contains(ident)) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -18,7 +19,7 @@ std::filesystem::path log::get_absolute_path(const std::string &ident) {
     throw std::invalid_argument("log identified with `" + ident + "` not found.");
   }
 
-  return log_registry_->at(ident).settings.absolute_path();
+  return log_ident->settings.absolute_path();
 }
 
 }
@@ -2,19 +2,25 @@
 
 namespace nutsloop {
 
-#if EXPERIMENTAL_INSTANCE
-
 std::unique_ptr<nlog::instance> log::get_instance( const std::string& ident ){
 
   // TODO: debug info
-  if ( !log_registry_->contains( ident ) ) {
+  log_t* log_ident = find_( ident );
+  if ( log_ident == nullptr ) {
     throw std::runtime_error( "log::get_instance(): log instance not found" );
   }
 
-  log_t* log_ident = &log_registry_->at( ident );
-  return std::make_unique<nlog::instance>( nlog::instance( log_ident ) );
+  return std::make_unique<nlog::instance>( log_ident );
 }
 
-#endif
+std::unique_ptr<nlog::instance> log::get_instance( const handle_t handle ){
+
+  log_t* log_ident = resolve_( handle );
+  if ( log_ident == nullptr ) {
+    throw std::runtime_error( "log::get_instance(): log instance not found" );
+  }
+
+  return std::make_unique<nlog::instance>( log_ident );
+}
 
 }
@@ -0,0 +1,14 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+Level log::get_level(const handle_t handle) {
+
+  if (resolve_(handle) == nullptr) {
+    throw std::invalid_argument(std::format("log handle `{}` not found.", handle.index));
+  }
+
+  return levels_[handle.index].load(std::memory_order_relaxed);
+}
+
+} // namespace nutsloop
@@ -2,8 +2,12 @@
 
 namespace nutsloop::nlog {
 
-std::ostream& instance::ostream() const {
-  return log_->stream;
+record instance::ostream() const {
+  return log::stream( handle() );
+}
+
+record instance::stream( const callsite_t& site ) const {
+  return log::stream( handle(), site );
 }
 
 }
@@ -0,0 +1,27 @@
+#include "log/mmap_sink.h++"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void mmap_sink::close() {
+
+  if (map_ != nullptr) {
+    ::munmap(map_, mapped_);
+    map_ = nullptr;
+    mapped_ = 0;
+  }
+
+  if (fd_ >= 0) {
+    // the zeroes past the last record are dropped.
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+      set_error_("cannot truncate");
+    }
+    ::close(fd_);
+    fd_ = -1;
+  }
+  size_ = 0;
+}
+
+} // namespace nutsloop::nlog
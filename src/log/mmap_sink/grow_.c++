@@ -0,0 +1,35 @@
+#include "log/mmap_sink.h++"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+bool mmap_sink::grow_(const std::size_t needed) {
+
+  const std::size_t mapped = (needed / segment_ + 1) * segment_;
+  const syscall_timer_t timer{*this};
+
+  if (map_ != nullptr) {
+    ::munmap(map_, mapped_);
+    map_ = nullptr;
+    mapped_ = 0;
+  }
+
+  // HINT: blocks are allocated now, a full disk fails here and not while a
+  //  record is being copied, which would raise SIGBUS.
+  if (::posix_fallocate(fd_, 0, static_cast<off_t>(mapped)) != 0) {
+    return false;
+  }
+
+  void *map = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (map == MAP_FAILED) {
+    return false;
+  }
+  map_ = static_cast<char *>(map);
+  mapped_ = mapped;
+  return true;
+}
+
+} // namespace nutsloop::nlog
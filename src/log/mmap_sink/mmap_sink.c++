@@ -0,0 +1,16 @@
+#include "log/mmap_sink.h++"
+
+#include <algorithm>
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+mmap_sink::mmap_sink(const sink_settings_t &settings)
+    : sink{settings.flush},
+      // HINT: the mapping grows by whole pages.
+      segment_{std::max(settings.segment_size, static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)))} {}
+
+mmap_sink::~mmap_sink() { mmap_sink::close(); }
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,43 @@
+#include "log/mmap_sink.h++"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+
+namespace nutsloop::nlog {
+
+bool mmap_sink::open(const std::filesystem::path &path, const bool truncate) {
+
+  close();
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+  if (fd_ < 0) {
+    set_error_("cannot open " + path.string());
+    return false;
+  }
+
+  struct stat status{};
+  if (::fstat(fd_, &status) != 0 || !grow_(static_cast<std::size_t>(status.st_size))) {
+    set_error_("cannot map " + path.string());
+    // HINT: not close(), which would truncate the file.
+    ::close(fd_);
+    fd_ = -1;
+    return false;
+  }
+
+  // a file left by a crash ends with the zeroes of its last segment, the
+  // records stop at the last byte that is not zero, unless end_ knows
+  // better (see `binary::end_of()`).
+  size_ = static_cast<std::size_t>(status.st_size);
+  if (end_ != nullptr) {
+    size_ = std::min(size_, end_({map_, size_}));
+  } else {
+    while (size_ > 0 && map_[size_ - 1] == '\0') {
+      --size_;
+    }
+  }
+  return true;
+}
+
+} // namespace nutsloop::nlog
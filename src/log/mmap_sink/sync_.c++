@@ -0,0 +1,20 @@
+#include "log/mmap_sink.h++"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void mmap_sink::sync_() {
+
+  if (map_ == nullptr) {
+    return;
+  }
+
+  const syscall_timer_t timer{*this};
+  if (::msync(map_, mapped_, MS_SYNC) != 0 || ::fdatasync(fd_) != 0) {
+    set_error_("cannot sync");
+  }
+}
+
+} // namespace nutsloop::nlog
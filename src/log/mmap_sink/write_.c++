@@ -0,0 +1,25 @@
+#include "log/mmap_sink.h++"
+
+#include <cstring>
+
+namespace nutsloop::nlog {
+
+void mmap_sink::write_(const std::string_view data) {
+
+  if (map_ == nullptr) {
+    return;
+  }
+
+  // HINT: without a mapping the sink is of no use, it closes, keeping the
+  //  records written so far.
+  if (size_ + data.size() > mapped_ && !grow_(size_ + data.size())) {
+    set_error_("cannot grow the mapping");
+    close();
+    return;
+  }
+
+  std::memcpy(map_ + size_, data.data(), data.size());
+  size_ += data.size();
+}
+
+} // namespace nutsloop::nlog
@@ -10,23 +10,23 @@ std::optional<log_t *> log::null_stream_(const std::string &ident) {
     return std::nullopt;
 
   // Check if the log_registry is nullptr
-  if (log_registry_ == nullptr) {
+  // HINT: read under the registry lock, see find_().
+  if (std::shared_lock lock(mtx_); log_registry_ == nullptr) {
     std::cerr << "[ERROR] log_registry_ is nullptr\n";
     // IDEA: Consider throwing an exception or handling error specifically
     return std::nullopt;
   }
 
   // Check if the identifier exists in log_registry_
-  if (!log_registry_->contains(ident)) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
     std::cerr << "[ERROR] Invalid log identifier '" << ident << "'.\n";
     // IDEA: Consider throwing an exception or handling error specifically
     return std::nullopt;
   }
 
-  log_t *log_ident = &log_registry_->at(ident);
-
   // Check if the log is active_
-  if (!log_ident->settings.get_active()) {
+  if (!log_ident->is_active()) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -35,7 +35,7 @@ std::optional<log_t *> log::null_stream_(const std::string &ident) {
       internal_debug_->stream(__FILE__, __LINE__, WARN)
           << std::format("log::null_stream_([{}]) called ⇣", ident) << '\n'
           << "  log is not active_: [ " << std::boolalpha
-          << log_ident->settings.get_active() << " ] " << '\n'
+          << log_ident->is_active() << " ] " << '\n'
           << "  returning a null_log_ (empty buffer)" << '\n';
     }
 #endif
@@ -61,7 +61,7 @@ std::optional<log_t *> log::null_stream_(const std::string &ident) {
   }
 
   // Check if the log file stream is open
-  if (!log_ident->stream.is_open()) {
+  if (!log_ident->is_open()) {
     std::cerr << "[ERROR] Log file stream is not open for identifier '" << ident
               << "'.\n";
     // IDEA: Consider throwing an exception or handling error specifically
@@ -0,0 +1,17 @@
+#include "log/ostream_sink.h++"
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void ostream_sink::close() {
+  if (stream_.is_open()) {
+    stream_.close();
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+} // namespace nutsloop::nlog
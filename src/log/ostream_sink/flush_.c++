@@ -0,0 +1,12 @@
+#include "log/ostream_sink.h++"
+
+namespace nutsloop::nlog {
+
+// HINT: the stream holds the records until it is flushed, the writes happen
+//  here.
+void ostream_sink::flush_() {
+  const syscall_timer_t timer{*this};
+  stream_.flush();
+}
+
+} // namespace nutsloop::nlog
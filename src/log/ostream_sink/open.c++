@@ -0,0 +1,36 @@
+#include "log/ostream_sink.h++"
+
+#include <fcntl.h>
+
+#include <string>
+
+namespace nutsloop::nlog {
+
+bool ostream_sink::open(const std::filesystem::path &path, const bool truncate) {
+
+  close();
+  path_ = path;
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND),
+               0644);
+  if (fd_ < 0) {
+    set_error_("cannot open " + path.string());
+    return false;
+  }
+
+  // HINT: the file is already truncated if it had to be, the stream appends.
+  stream_.clear();
+  stream_.open("/proc/self/fd/" + std::to_string(fd_), std::ios::out | std::ios::app);
+  if (!stream_.is_open()) {
+    // without /proc, the path still names the file fd_ was opened on.
+    stream_.clear();
+    stream_.open(path, std::ios::out | std::ios::app);
+  }
+  if (!stream_.is_open()) {
+    set_error_("cannot open " + path.string());
+    close();
+    return false;
+  }
+  return true;
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,9 @@
+#include "log/ostream_sink.h++"
+
+namespace nutsloop::nlog {
+
+ostream_sink::ostream_sink(const sink_settings_t &settings) : sink{settings.flush} {}
+
+ostream_sink::~ostream_sink() { ostream_sink::close(); }
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,20 @@
+#include "log/ostream_sink.h++"
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void ostream_sink::sync_() {
+
+  if (fd_ < 0) {
+    return;
+  }
+
+  const syscall_timer_t timer{*this};
+  // HINT: fd_ and the stream share the file, syncing one syncs the other.
+  if (::fsync(fd_) != 0) {
+    set_error_("cannot sync " + path_.string());
+  }
+}
+
+} // namespace nutsloop::nlog
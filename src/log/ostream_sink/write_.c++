@@ -0,0 +1,9 @@
+#include "log/ostream_sink.h++"
+
+namespace nutsloop::nlog {
+
+void ostream_sink::write_(const std::string_view data) {
+  stream_.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+} // namespace nutsloop::nlog
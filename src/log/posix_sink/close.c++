@@ -0,0 +1,16 @@
+#include "log/posix_sink.h++"
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void posix_sink::close() {
+  if (fd_ < 0) {
+    return;
+  }
+  flush_();
+  ::close(fd_);
+  fd_ = -1;
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,18 @@
+#include "log/posix_sink.h++"
+
+#include <sys/uio.h>
+
+namespace nutsloop::nlog {
+
+void posix_sink::flush_() {
+
+  if (size_ == 0) {
+    return;
+  }
+
+  iovec vector{buffer_.get(), size_};
+  writev_(&vector, 1);
+  size_ = 0;
+}
+
+} // namespace nutsloop::nlog
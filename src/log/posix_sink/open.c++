@@ -0,0 +1,19 @@
+#include "log/posix_sink.h++"
+
+#include <fcntl.h>
+
+namespace nutsloop::nlog {
+
+bool posix_sink::open(const std::filesystem::path &path, const bool truncate) {
+
+  close();
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND),
+               0644);
+  if (fd_ < 0) {
+    set_error_("cannot open " + path.string());
+    return false;
+  }
+  return true;
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,11 @@
+#include "log/posix_sink.h++"
+
+namespace nutsloop::nlog {
+
+posix_sink::posix_sink(const sink_settings_t &settings)
+    : sink{settings.flush}, capacity_{settings.buffer_size},
+      buffer_{std::make_unique<char[]>(settings.buffer_size)} {}
+
+posix_sink::~posix_sink() { posix_sink::close(); }
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,14 @@
+#include "log/posix_sink.h++"
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void posix_sink::sync_() {
+  const syscall_timer_t timer{*this};
+  if (fd_ >= 0 && ::fdatasync(fd_) != 0) {
+    set_error_("cannot sync");
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,27 @@
+#include "log/posix_sink.h++"
+
+#include <array>
+#include <cstring>
+
+#include <sys/uio.h>
+
+namespace nutsloop::nlog {
+
+void posix_sink::write_(const std::string_view data) {
+
+  if (size_ + data.size() <= capacity_) {
+    std::memcpy(buffer_.get() + size_, data.data(), data.size());
+    size_ += data.size();
+    return;
+  }
+
+  // the buffer and the record go out together, the record is not copied.
+  std::array<iovec, 2> vectors{{
+      {buffer_.get(), size_},
+      {const_cast<char *>(data.data()), data.size()},
+  }};
+  writev_(vectors.data(), static_cast<int>(vectors.size()));
+  size_ = 0;
+}
+
+} // namespace nutsloop::nlog
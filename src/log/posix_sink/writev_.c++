@@ -0,0 +1,40 @@
+#include "log/posix_sink.h++"
+
+#include <cerrno>
+
+#include <sys/uio.h>
+
+namespace nutsloop::nlog {
+
+void posix_sink::writev_(iovec *vectors, int count) {
+
+  if (fd_ < 0) {
+    return;
+  }
+
+  const syscall_timer_t timer{*this};
+  while (count > 0) {
+    const ssize_t written = ::writev(fd_, vectors, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // HINT: what is left of the vectors is dropped, see `sink::write()`.
+      set_error_("cannot write");
+      return;
+    }
+    // skips what has been written, a short write resumes where it stopped.
+    auto remaining = static_cast<std::size_t>(written);
+    while (count > 0 && remaining >= vectors->iov_len) {
+      remaining -= vectors->iov_len;
+      ++vectors;
+      --count;
+    }
+    if (count > 0) {
+      vectors->iov_base = static_cast<char *>(vectors->iov_base) + remaining;
+      vectors->iov_len -= remaining;
+    }
+  }
+}
+
+} // namespace nutsloop::nlog
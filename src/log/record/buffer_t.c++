@@ -0,0 +1,48 @@
+#include "log/record.h++"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nutsloop::nlog {
+
+void record::buffer_t::append(const char *data, const std::size_t size) {
+
+  if (static_cast<std::size_t>(epptr() - pptr()) < size) {
+    grow_(size);
+  }
+  std::memcpy(pptr(), data, size);
+  pbump(static_cast<int>(size));
+}
+
+int record::buffer_t::overflow(const int input) {
+
+  if (traits_type::eq_int_type(input, traits_type::eof())) {
+    return traits_type::not_eof(input);
+  }
+
+  const char character = traits_type::to_char_type(input);
+  append(&character, 1);
+
+  return input;
+}
+
+std::streamsize record::buffer_t::xsputn(const char *input, const std::streamsize count) {
+  append(input, static_cast<std::size_t>(count));
+  return count;
+}
+
+void record::buffer_t::grow_(const std::size_t needed) {
+
+  const auto used = static_cast<std::size_t>(pptr() - pbase());
+  const std::size_t capacity =
+      std::max(2 * static_cast<std::size_t>(epptr() - pbase()), used + needed);
+
+  auto heap = std::make_unique_for_overwrite<char[]>(capacity);
+  std::memcpy(heap.get(), pbase(), used);
+  heap_ = std::move(heap);
+
+  setp(heap_.get(), heap_.get() + capacity);
+  pbump(static_cast<int>(used));
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,42 @@
+#include "log/record.h++"
+
+#include "log/async_writer.h++"
+#include "log/rotation.h++"
+#include "log/sink.h++"
+
+#include <mutex>
+
+namespace nutsloop::nlog {
+
+void record::commit_() {
+
+  const std::string_view line = buffer_.view();
+
+  if (binary_) {
+    binary::store_record(buffer_.data(), line.size(),
+                         {
+                             .time = binary::now(),
+                             .thread = binary::thread_id(),
+                             .site = reinterpret_cast<std::uintptr_t>(site_),
+                             .format = reinterpret_cast<std::uintptr_t>(format_.data()),
+                             .format_size = static_cast<std::uint32_t>(format_.size()),
+                             .level = static_cast<std::uint8_t>(level_),
+                         });
+  }
+
+  if (log_->writer != nullptr) {
+    // HINT: copied straight from the inline buffer into the queue cell.
+    log_->writer->push(line, nullptr, level_);
+    return;
+  }
+
+  { // MARK (record) MUTEX LOCK
+    std::lock_guard lock(log_->io_mtx);
+    log_->sink->write(line, level_);
+    if (log_->rotation != nullptr) {
+      log_->rotation->written(line.size());
+    }
+  }
+}
+
+} // namespace nutsloop::nlog
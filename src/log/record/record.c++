@@ -0,0 +1,52 @@
+#include "log/record.h++"
+
+namespace nutsloop::nlog {
+
+record::record(log_t *log, const callsite_t *site /*= nullptr*/)
+    : log_{log}, site_{site}, level_{site != nullptr ? site->level : NONE} {
+
+  if (log_ == nullptr) {
+    return;
+  }
+
+  // a binary record has no prefix, the call site is an id in its header.
+  if (log_->settings.get_encoding() == encoding_t::BINARY) {
+    binary_ = true;
+    static constexpr std::array<char, binary::record_offset> header{};
+    buffer_.append(header.data(), header.size());
+    return;
+  }
+
+  if (site_ != nullptr) {
+    buffer_.append(site_->prefix.data(), site_->prefix.size());
+  }
+}
+
+record::~record() {
+  if (log_ != nullptr && buffer_.view().size() > (binary_ ? binary::record_offset : 0)) {
+    commit_();
+  }
+}
+
+record &record::operator<<(std::ostream &(*manipulator)(std::ostream &)) {
+  if (log_ != nullptr) {
+    fallback_stream_() << manipulator;
+  }
+  return *this;
+}
+
+record &record::operator<<(std::ios_base &(*manipulator)(std::ios_base &)) {
+  if (log_ != nullptr) {
+    fallback_stream_() << manipulator;
+  }
+  return *this;
+}
+
+std::ostream &record::fallback_stream_() {
+  if (!fallback_.has_value()) {
+    fallback_.emplace(&buffer_);
+  }
+  return *fallback_;
+}
+
+} // namespace nutsloop::nlog
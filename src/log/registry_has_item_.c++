@@ -4,7 +4,13 @@ namespace nutsloop {
 
 bool log::registry_has_item_(std::string ident) {
 
-  if (log_registry_->contains(ident)) {
+  bool contains;
+  { // MARK (LOG) MUTEX LOCK
+    std::shared_lock lock(mtx_);
+    contains = log_registry_->contains(ident);
+  }
+
+  if (contains) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -0,0 +1,100 @@
+#include "log/rotation.h++"
+
+#include <fstream>
+#include <system_error>
+#include <vector>
+
+#ifdef NLOG_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef NLOG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+namespace nutsloop::nlog {
+
+bool rotation::compress_(const std::filesystem::path &source,
+                         const std::filesystem::path &destination,
+                         const compression_t compression) {
+
+  std::ifstream in(source, std::ios::binary);
+  if (!in) {
+    return false;
+  }
+
+  // HINT: written aside and renamed once complete, a compressed generation
+  //  is never left half written.
+  std::filesystem::path partial = destination;
+  partial += ".partial";
+
+  [[maybe_unused]] std::vector<char> chunk(128 * 1024);
+  bool done = false;
+
+  switch (compression) {
+  case compression_t::GZIP: {
+#ifdef NLOG_HAVE_ZLIB
+    const gzFile out = gzopen(partial.c_str(), "wb6");
+    if (out == nullptr) {
+      return false;
+    }
+    done = true;
+    for (bool last = false; done && !last;) {
+      in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      last = !in;
+      if (in.gcount() > 0 &&
+          gzwrite(out, chunk.data(), static_cast<unsigned>(in.gcount())) == 0) {
+        done = false;
+      }
+    }
+    done = gzclose(out) == Z_OK && done;
+#endif
+    break;
+  }
+  case compression_t::ZSTD: {
+#ifdef NLOG_HAVE_ZSTD
+    std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+    ZSTD_CCtx *context = ZSTD_createCCtx();
+    if (!out || context == nullptr) {
+      ZSTD_freeCCtx(context);
+      return false;
+    }
+    std::vector<char> output(ZSTD_CStreamOutSize());
+    done = true;
+    for (bool last = false; done && !last;) {
+      in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      last = !in;
+      ZSTD_inBuffer input{chunk.data(), static_cast<std::size_t>(in.gcount()), 0};
+      const ZSTD_EndDirective mode = last ? ZSTD_e_end : ZSTD_e_continue;
+      for (bool flushed = false; done && !flushed;) {
+        ZSTD_outBuffer buffer{output.data(), output.size(), 0};
+        const std::size_t remaining = ZSTD_compressStream2(context, &buffer, &input, mode);
+        if (ZSTD_isError(remaining)) {
+          done = false;
+          break;
+        }
+        out.write(output.data(), static_cast<std::streamsize>(buffer.pos));
+        flushed = last ? remaining == 0 : input.pos == input.size;
+      }
+    }
+    ZSTD_freeCCtx(context);
+    out.close();
+    done = done && !out.fail();
+#endif
+    break;
+  }
+  case compression_t::NONE:
+    break;
+  }
+
+  done = done && !in.bad();
+
+  std::error_code error;
+  if (done) {
+    std::filesystem::rename(partial, destination, error);
+  } else {
+    std::filesystem::remove(partial, error);
+  }
+  return done && !error;
+}
+
+} // namespace nutsloop::nlog
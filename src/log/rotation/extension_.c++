@@ -0,0 +1,17 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+const char *rotation::extension_(const compression_t compression) {
+  switch (compression) {
+  case compression_t::GZIP:
+    return ".gz";
+  case compression_t::ZSTD:
+    return ".zst";
+  case compression_t::NONE:
+    break;
+  }
+  return "";
+}
+
+} // namespace nutsloop::nlog
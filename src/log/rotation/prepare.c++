@@ -0,0 +1,7 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+void rotation::prepare() { worker_(); }
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,10 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+void rotation::reset_() {
+  bytes_ = 0;
+  deadline_ = std::chrono::steady_clock::now() + settings_.interval;
+}
+
+} // namespace nutsloop::nlog
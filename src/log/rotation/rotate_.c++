@@ -0,0 +1,43 @@
+#include "log/rotation.h++"
+
+#include "log.h++"
+#include "log/sink.h++"
+
+#include <format>
+#include <system_error>
+
+namespace nutsloop::nlog {
+
+void rotation::rotate_() {
+
+  // HINT: a name no other rotation takes, the background thread gives the
+  //  file its generation later on.
+  std::filesystem::path pending = path_;
+  pending += std::format(".{}.rotating",
+                         std::chrono::system_clock::now().time_since_epoch().count());
+
+  log_.sink->close();
+  std::error_code error;
+  std::filesystem::rename(path_, pending, error);
+  // if the file could not be renamed, it keeps growing until the next attempt.
+  log_.set_open(log_.sink->open(path_, false));
+  reset_();
+
+  // the new file starts with a session header, as log::set() writes it.
+  // HINT: counted as written, it is part of the file like any record.
+  if (log_.is_open() && log_.settings.get_encoding() != encoding_t::BINARY &&
+      !log_.settings.get_session_header()) {
+    const std::string header =
+        std::format("\n{}\n\n", log::generate_new_session_header_(log_.settings.get_ident(),
+                                                                    path_.string()));
+    log_.sink->write(header, NONE, 0);
+    log_.sink->flush();
+    bytes_ += header.size();
+  }
+
+  if (!error) {
+    worker_().post(job_t{std::move(pending), path_, settings_.generations, settings_.compression});
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,10 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+rotation::rotation(log_t &log, std::filesystem::path path, const rotation_settings_t &settings,
+                   const std::uint64_t size)
+    : log_{log}, path_{std::move(path)}, settings_{settings}, bytes_{size},
+      deadline_{std::chrono::steady_clock::now() + settings.interval} {}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,54 @@
+#include "log/rotation.h++"
+
+#include <array>
+#include <format>
+#include <system_error>
+
+namespace nutsloop::nlog {
+
+void rotation::shift_(const job_t &job) {
+
+  namespace fs = std::filesystem;
+  std::error_code error;
+
+  if (job.generations == 0) {
+    fs::remove(job.pending, error);
+    return;
+  }
+
+  const auto generation = [&job](const std::size_t number, const char *extension) {
+    fs::path path = job.path;
+    path += std::format(".{}{}", number, extension);
+    return path;
+  };
+
+  // HINT: a generation may be compressed or not, depending on the settings
+  //  the program had when it was rotated.
+  static constexpr std::array extensions{"", ".gz", ".zst"};
+
+  for (std::size_t number = job.generations; number >= 1; --number) {
+    for (const char *extension : extensions) {
+      const fs::path from = generation(number, extension);
+      if (!fs::exists(from, error)) {
+        continue;
+      }
+      if (number == job.generations) {
+        fs::remove(from, error);
+      } else {
+        fs::rename(from, generation(number + 1, extension), error);
+      }
+    }
+  }
+
+  const fs::path first = generation(1, "");
+  fs::rename(job.pending, first, error);
+  if (error || job.compression == compression_t::NONE) {
+    return;
+  }
+
+  if (compress_(first, generation(1, extension_(job.compression)), job.compression)) {
+    fs::remove(first, error);
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,7 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+void rotation::wait() { worker_().wait(); }
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,12 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+rotation::worker_t &rotation::worker_() {
+  // HINT: built by prepare() or the first rotation, joined when the
+  //  program exits.
+  static worker_t worker;
+  return worker;
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,59 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+rotation::worker_t::~worker_t() {
+  {
+    std::lock_guard lock(mtx_);
+    stopping_ = true;
+  }
+  jobs_cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void rotation::worker_t::post(job_t &&job) {
+  {
+    std::lock_guard lock(mtx_);
+    jobs_.push_back(std::move(job));
+    if (!thread_.joinable()) {
+      thread_ = std::thread{&worker_t::run_, this};
+    }
+  }
+  jobs_cv_.notify_one();
+}
+
+void rotation::worker_t::wait() {
+  std::unique_lock lock(mtx_);
+  idle_cv_.wait(lock, [this] { return jobs_.empty() && !busy_; });
+}
+
+void rotation::worker_t::run_() {
+
+  for (;;) {
+
+    job_t job;
+    {
+      std::unique_lock lock(mtx_);
+      jobs_cv_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+      // every job posted before stopping is done first.
+      if (jobs_.empty()) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      busy_ = true;
+    }
+
+    shift_(job);
+
+    {
+      std::lock_guard lock(mtx_);
+      busy_ = false;
+    }
+    idle_cv_.notify_all();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,19 @@
+#include "log/rotation.h++"
+
+namespace nutsloop::nlog {
+
+void rotation::written(const std::size_t bytes) {
+
+  bytes_ += bytes;
+
+  // HINT: the clock is only read when time based rotation is enabled.
+  const bool oversized = settings_.max_size > 0 && bytes_ >= settings_.max_size;
+  const bool expired =
+      settings_.interval.count() > 0 && std::chrono::steady_clock::now() >= deadline_;
+
+  if (oversized || expired) {
+    rotate_();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -1,11 +1,15 @@
 #include "log.h++"
 
+#include "log/binary_sink.h++"
+#include "util/uintptr.h++"
+
 #include <iostream>
+#include <system_error>
 
 
 namespace nutsloop {
 
-void log::set(log_settings_t &settings) {
+handle_t log::set(log_settings_t &settings) {
 
   // GOOD internal debug logging system.
 
@@ -27,7 +31,7 @@ void log::set(log_settings_t &settings) {
   set_log_registry_();
 
   if (registry_has_item_(settings.get_ident())) {
-    return;
+    return handle_t{find_(settings.get_ident())->handle};
   }
 
   // ONGOING: setting up the registry
@@ -58,19 +62,23 @@ void log::set(log_settings_t &settings) {
   bool renamed = false;
   const std::filesystem::path log_file_path =
       nutsloop_logs_directory / log_ident->settings.get_filename();
-  if (std::filesystem::exists(log_file_path) &&
+  const rotation_settings_t rotation = log_ident->settings.get_rotation();
+  // HINT: a rotated log never needs the startup backup, it is rotated while
+  //  it is written.
+  if (!rotation.enabled() && std::filesystem::exists(log_file_path) &&
       std::filesystem::file_size(log_file_path) > LOG_MAX_SIZE) {
     const std::string backup_path =
         nutsloop_logs_directory / (log_ident->settings.get_filename() + ".backup");
-    if (log_ident->stream.is_open()) {
-      log_ident->stream.close();
-    }
     std::filesystem::rename(log_file_path, backup_path); // Archive existing log
     renamed = true;
   }
 
-  log_ident->stream.open(log_file_path,
-                         std::ios::out | (renamed ? std::ios::trunc : std::ios::app));
+  log_ident->sink = nlog::make_sink(log_ident->settings.get_sink());
+  const bool binary = log_ident->settings.get_encoding() == encoding_t::BINARY;
+  if (binary) {
+    log_ident->sink = std::make_shared<nlog::binary_sink>(std::move(log_ident->sink));
+  }
+  log_ident->sink->open(log_file_path, renamed);
   std::optional<std::string> log_file_stream_error = error_on_log_file_(log_ident);
   if (log_file_stream_error) {
     throw std::runtime_error(*log_file_stream_error);
@@ -79,21 +87,71 @@ void log::set(log_settings_t &settings) {
   // HINT: maybe find a purpose for this? :D
   // if ( is_stream_redirect_active_() ) {}
 
-  log_ident->stream << std::unitbuf;
+  // HINT: no std::unitbuf, the sink flushes according to its flush_policy_t.
 
   // Add the default session header if the custom one has not been set.
-  if (!log_ident->settings.get_session_header()) {
-    log_ident->stream << '\n'
-                      << generate_new_session_header_(log_ident->settings.get_ident(),
-                                                      log_file_path) // Add session header
-                      << '\n'
-                      << '\n';
+  // HINT: a binary log has none, its SYNC frames tell where a run starts.
+  //  Written with `io_mtx` held, like every other write to the sink.
+  if (!binary && !log_ident->settings.get_session_header()) {
+    std::lock_guard io_lock(log_ident->io_mtx);
+    log_ident->sink->write(std::format("\n{}\n\n", generate_new_session_header_(
+                                                          log_ident->settings.get_ident(),
+                                                          log_file_path)), // Add session header
+                           NONE, 0);
+    log_ident->sink->flush();
   }
   // TODO: handle custom log header
   else {
   }
 
+  // from now on, the bytes written are counted, the file is asked for its
+  // size this once.
+  if (rotation.enabled()) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(log_file_path, error);
+    log_ident->rotation = std::make_shared<nlog::rotation>(*log_ident, log_file_path, rotation,
+                                                           error ? 0 : size);
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock(mtx_);
+      internal_debug_->stream(__FILE__, __LINE__, INFO)
+          << std::format("log [{}] is rotated, max_size[{}] interval[{}] generations[{}].",
+                         log_ident->settings.get_ident(), rotation.max_size,
+                         rotation.interval.count(), rotation.generations)
+          << std::endl;
+    }
+#endif
+  }
+
+  // from now on, an asynchronous log is written by its own writer thread only.
+  if (log_ident->settings.get_async().enabled) {
+    log_ident->writer = std::make_shared<nlog::async_writer>(
+        *log_ident->sink, log_ident->io_mtx, log_ident->settings.get_async(),
+        log_ident->rotation.get());
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock(mtx_);
+      internal_debug_->stream(__FILE__, __LINE__, INFO)
+          << std::format("log [{}] is asynchronous, writer thread started.",
+                         log_ident->settings.get_ident())
+          << '\n'
+          << std::format("  writer pointer @ -> 0x{:x}", uintptr(log_ident->writer.get()))
+          << std::endl;
+    }
+#endif
+  }
+
+  // from now on, the log can be written: the header, the rotation and the
+  // writer are in place before any record gets to them.
+  // HINT: the log is findable since set_log_(), its state is what keeps
+  //  records away until here.
+  log_ident->set_open(true);
+
   // ONGOING: setting up the log
+
+  return handle_t{log_ident->handle};
 }
 
 } // namespace nutsloop
@@ -0,0 +1,35 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+void log::set_level(const handle_t handle, const Level c) {
+
+  if (resolve_(handle) == nullptr) {
+    throw std::invalid_argument(std::format("log handle `{}` not found.", handle.index));
+  }
+
+  levels_[handle.index].store(c, std::memory_order_relaxed);
+}
+
+void log::set_level(const std::string &ident, const Level c) {
+
+  const log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock(mtx_);
+      internal_debug_->stream(__FILE__, __LINE__, ERROR)
+          << ansi("log::set_level([{}]) called ⇣", ident).red().bold() << '\n'
+          << ansi("    log identified with `{}` not found.", ident).red() << '\n'
+          << "    throw std::invalid_argument" << '\n';
+    }
+#endif
+
+    throw std::invalid_argument("log identified with `" + ident + "` not found.");
+  }
+
+  levels_[log_ident->handle].store(c, std::memory_order_relaxed);
+}
+
+} // namespace nutsloop
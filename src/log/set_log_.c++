@@ -2,40 +2,53 @@
 
 #include "util/uintptr.h++"
 
+#include <stdexcept>
+
 namespace nutsloop{
 
 log_t* log::set_log_(log_settings_t* settings) {
 
-  if (log_ == nullptr) {
+  // HINT: log_t owns a mutex, so it is built in place, the registry nodes
+  //  never move afterwards.
+  std::pair<log_registry_t::iterator, bool> emplaced;
+  { // MARK (LOG) MUTEX LOCK
+    // HINT: find_() reads the registry concurrently, a rehash must not run
+    //  under it.
+    std::unique_lock lock(mtx_);
+
+    if (!log_registry_->contains(settings->get_ident()) &&
+        handles_size_.load(std::memory_order_relaxed) >= LOG_MAX_HANDLES) {
+      throw std::length_error(std::format("log::set(): no handle left for `{}`, {} logs already set.",
+                                          settings->get_ident(), LOG_MAX_HANDLES));
+    }
 
-    log_ = std::make_unique<log_t>(*settings);
+    emplaced = log_registry_->try_emplace(settings->get_ident(), *settings);
 
-#if DEBUG_LOG == true
-    { // MARK (LOG) MUTEX LOCK
-      std::shared_lock lock(mtx_);
-      internal_debug_->stream(__FILE__, __LINE__, INFO)
-          << "log_ is nullptr, construct..." << '\n'
-          << std::format("pointer @ -> 0x{:x}", uintptr( log_ ))
-          << std::endl;
+    // every new log takes the next slot of the handle table, the slot is
+    // published once the log is fully built.
+    if (emplaced.second) {
+      const std::uint32_t index = handles_size_.fetch_add(1, std::memory_order_relaxed);
+      emplaced.first->second.handle = index;
+      levels_[index].store(settings->get_level(), std::memory_order_relaxed);
+      handles_[index].store(&emplaced.first->second, std::memory_order_release);
     }
-#endif
   }
-
-  log_registry_->insert_or_assign(settings->get_ident(), std::move(*log_));
-
-  log_.reset();
+  auto [iterator, inserted] = emplaced;
 
 #if DEBUG_LOG == true
   { // MARK (LOG) MUTEX LOCK
     std::shared_lock lock(mtx_);
     internal_debug_->stream(__FILE__, __LINE__, INFO)
-        << "log_ is being destroyed..." << '\n'
-        << std::format("pointer @ -> 0x{:x}", uintptr( log_ ))
+        << std::format("log_t [{}] {}...", settings->get_ident(),
+                       inserted ? "constructed in place" : "already in the registry")
+        << '\n'
+        << std::format("pointer @ -> 0x{:x}", uintptr( &iterator->second )) << '\n'
+        << std::format("handle  -> [ {} ]", iterator->second.handle)
         << std::endl;
   }
 #endif
 
-  return &log_registry_->at(settings->get_ident());
+  return &iterator->second;
 
 }
 
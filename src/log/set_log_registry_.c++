@@ -2,12 +2,29 @@
 
 #include "util/uintptr.h++"
 
+#include <cstdlib>
+
 namespace nutsloop {
 
 void log::set_log_registry_() {
 
-  if (log_registry_ == nullptr) {
-    log_registry_ = std::make_unique<log_registry_t>();
+  bool created = false;
+  { // MARK (LOG) MUTEX LOCK
+    std::unique_lock lock(mtx_);
+    if (log_registry_ == nullptr) {
+      log_registry_ = std::make_unique<log_registry_t>();
+      created = true;
+    }
+  }
+
+  if (created) {
+
+    // the writers are stopped at exit, before the rotation worker they may
+    // post to is destroyed, the worker is built first for that.
+    // HINT: the registry itself is constant-initialised, it is destroyed
+    //  after every function-local static.
+    nlog::rotation::prepare();
+    std::atexit(shutdown_);
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
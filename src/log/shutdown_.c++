@@ -0,0 +1,22 @@
+#include "log.h++"
+
+namespace nutsloop {
+
+void log::shutdown_() {
+
+  // MARK (LOG) MUTEX LOCK
+  std::shared_lock lock(mtx_);
+
+  if (log_registry_ == nullptr) {
+    return;
+  }
+
+  // HINT: the logs themselves are destroyed later on, with the registry.
+  for (auto &[ident, log_ident] : *log_registry_) {
+    if (log_ident.writer != nullptr) {
+      log_ident.writer->stop();
+    }
+  }
+}
+
+} // namespace nutsloop
@@ -0,0 +1,14 @@
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+counters_t sink::counters() const {
+  return {
+      .records = records_.load(std::memory_order_relaxed),
+      .bytes = bytes_.load(std::memory_order_relaxed),
+      .flushes = flushes_.load(std::memory_order_relaxed),
+      .write_time = std::chrono::nanoseconds{write_ns_.load(std::memory_order_relaxed)},
+  };
+}
+
+} // namespace nutsloop::nlog
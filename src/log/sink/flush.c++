@@ -0,0 +1,17 @@
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+void sink::flush() {
+
+  flush_();
+  if (pending_ > 0) {
+    add_(flushes_, 1);
+  }
+  pending_ = 0;
+  if (policy_.interval.count() > 0) {
+    flushed_at_ = std::chrono::steady_clock::now();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,32 @@
+#include "log/sink.h++"
+
+#include "log/mmap_sink.h++"
+#include "log/ostream_sink.h++"
+#include "log/posix_sink.h++"
+#include "log/uring_sink.h++"
+
+namespace nutsloop::nlog {
+
+std::shared_ptr<sink> make_sink(const sink_settings_t &settings) {
+
+  switch (settings.type) {
+  case sink_type_t::POSIX:
+    return std::make_shared<posix_sink>(settings);
+  case sink_type_t::IO_URING:
+#ifdef NLOG_HAVE_LIBURING
+    if (auto uring = std::make_shared<uring_sink>(settings); uring->supported()) {
+      return uring;
+    }
+#endif
+    // HINT: the build or the kernel lacks io_uring.
+    return std::make_shared<posix_sink>(settings);
+  case sink_type_t::MMAP:
+    return std::make_shared<mmap_sink>(settings);
+  case sink_type_t::OSTREAM:
+    break;
+  }
+
+  return std::make_shared<ostream_sink>(settings);
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,16 @@
+#include "log/sink.h++"
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+
+namespace nutsloop::nlog {
+
+sink::sink(const flush_policy_t &policy)
+    : policy_{policy}, flushed_at_{std::chrono::steady_clock::now()} {}
+
+void sink::set_error_(const std::string_view what) {
+  error_ = std::format("{}: {}", what, std::strerror(errno));
+}
+
+} // namespace nutsloop::nlog
@@ -0,0 +1,10 @@
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+void sink::sync() {
+  flush();
+  sync_();
+}
+
+} // namespace nutsloop::nlog
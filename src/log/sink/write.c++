@@ -0,0 +1,30 @@
+#include "log/sink.h++"
+
+namespace nutsloop::nlog {
+
+void sink::write(const std::string_view data, const Level level,
+                 const std::size_t records /*= 1*/) {
+
+  // HINT: nothing reaches a closed sink, the records are not counted either.
+  if (!is_open()) {
+    return;
+  }
+
+  write_(data);
+  // HINT: a sink failing for good closes itself, the record went nowhere.
+  if (!is_open()) {
+    return;
+  }
+  pending_ += data.size();
+  add_(records_, records);
+  add_(bytes_, data.size());
+
+  // HINT: the clock is only read when the interval is enabled.
+  if (pending_ >= policy_.size || (policy_.on_error && level == ERROR) ||
+      (policy_.interval.count() > 0 &&
+       std::chrono::steady_clock::now() - flushed_at_ >= policy_.interval)) {
+    flush();
+  }
+}
+
+} // namespace nutsloop::nlog
@@ -4,7 +4,8 @@ namespace nutsloop {
 
 void log::start(const std::string &ident) {
 
-  if (!log_registry_->contains(ident)) {
+  log_t *log_ident = find_(ident);
+  if (log_ident == nullptr) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -27,7 +28,6 @@ void log::start(const std::string &ident) {
   }
 #endif
 
-  log_t *log_ident = &log_registry_->at(ident);
   const bool previous_running_status = log_ident->is_running();
   log_ident->set_running(true);
 
@@ -42,8 +42,8 @@ void log::start(const std::string &ident) {
   }
 #endif
 
-  const bool previous_active_status = log_ident->settings.get_active();
-  log_ident->settings.set_active(true);
+  const bool previous_active_status = log_ident->is_active();
+  log_ident->set_active(true);
 
 #if DEBUG_LOG == true
   { // MARK (LOG) MUTEX LOCK
@@ -1,11 +1,11 @@
 #include "log.h++"
 
+#include "log/callsite.h++"
 #include "util/level.h++"
-#include "util/shortened_path.h++"
 
 namespace nutsloop {
 
-std::ostream& log::stream( const char* ident, const char* file, const int line, const Level c /*= INFO*/ ) {
+nlog::record log::stream( const char* ident, const char* file, const int line, const Level c /*= INFO*/ ) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -18,22 +18,32 @@ std::ostream& log::stream( const char* ident, const char* file, const int line,
   const std::optional<log_t*> null_stream = null_stream_( ident );
   log_t* log_ident = nullptr;
   if ( null_stream ) log_ident = null_stream.value();
-  else return null_log_;
-
-  { // MARK (LOG) MUTEX LOCK
-    std::shared_lock lock( mtx_ );
-
-    const std::string level_stream = std::format("[{}] ", level( c ) );
-    const std::string shortened_path_stream = strlen( file ) == 0 ? "" : std::format("{}", shortened_path( file ) );
-    const std::string line_stream = line == 0 ? "" : std::format("{}", line );
-    const std::string location_stream = std::format( "[{}:{}]", shortened_path_stream, line_stream );
-    // Write log prefix with level, file, and line
-    log_ident->stream << level_stream << location_stream;
-    return log_ident->stream;
+  else return {};
+  if ( !level_enabled_( log_ident, c ) ) return {};
+
+  // The record starts with the log prefix: level, file, and line,
+  // computed once per call site.
+  return nlog::record{ log_ident, &nlog::callsite( file, line, c ) };
+}
+
+nlog::record log::stream( const char* ident, const nlog::callsite_t& site ) {
+
+#if DEBUG_LOG == true
+    { // MARK (LOG) MUTEX LOCK
+      std::shared_lock lock( mtx_ );
+      const std::string log_stream_signature = std::format("log::stream( ident_[{}], site[{}] ) called ⇣", ident, site.prefix );
+      internal_debug_->stream( __FILE__, __LINE__, INFO ) << log_stream_signature << std::endl;
+    }
+#endif
+
+  if ( const std::optional<log_t*> null_stream = null_stream_( ident ); null_stream && level_enabled_( null_stream.value(), site.level ) ) {
+    return nlog::record{ null_stream.value(), &site };
   }
+
+  return {};
 }
 
-std::ostream& log::stream( const char* ident ) {
+nlog::record log::stream( const char* ident ) {
 
 #if DEBUG_LOG == true
     { // MARK (LOG) MUTEX LOCK
@@ -43,10 +53,28 @@ std::ostream& log::stream( const char* ident ) {
     }
 #endif
 
-  if ( const std::optional<log_t*> null_stream = null_stream_( ident ) ) return null_stream.value()->stream;
+  if ( const std::optional<log_t*> null_stream = null_stream_( ident ) ) return nlog::record{ null_stream.value() };
+
+  return {};
+
+}
+
+nlog::record log::stream( const handle_t handle, const nlog::callsite_t& site ) {
+
+  // HINT: the hot path, no debug stream here, it would take mtx_ on every record.
+  if ( !enabled( handle, site.level ) ) return {};
+  log_t* log_ident = resolve_( handle );
+  if ( log_ident == nullptr || !writable_( log_ident ) ) return {};
+
+  return nlog::record{ log_ident, &site };
+}
+
+nlog::record log::stream( const handle_t handle ) {
 
-  return null_log_;
+  log_t* log_ident = resolve_( handle );
+  if ( log_ident == nullptr || !writable_( log_ident ) ) return {};
 
+  return nlog::record{ log_ident };
 }
 
 }
@@ -0,0 +1,21 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void uring_sink::close() {
+  if (fd_ < 0) {
+    return;
+  }
+  flush_();
+  wait_();
+  ::close(fd_);
+  fd_ = -1;
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,44 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+namespace nutsloop::nlog {
+
+void uring_sink::flush_() {
+
+  if (size_ == 0 || fd_ < 0) {
+    return;
+  }
+
+  // HINT: the other buffer must be written before it is reused, and before
+  //  this one is, so records keep their order.
+  wait_();
+
+  io_uring_sqe *entry = ::io_uring_get_sqe(&ring_);
+  if (entry == nullptr) {
+    write_all_(buffers_[current_].get(), size_);
+    size_ = 0;
+    return;
+  }
+  // HINT: -1 writes at the current position, the file is opened in append mode.
+  ::io_uring_prep_write(entry, fd_, buffers_[current_].get(), static_cast<unsigned>(size_),
+                        static_cast<__u64>(-1));
+  int submitted; // NOLINT(*-init-variables)
+  {
+    const syscall_timer_t timer{*this};
+    submitted = ::io_uring_submit(&ring_);
+  }
+  if (submitted < 0) {
+    write_all_(buffers_[current_].get(), size_);
+    size_ = 0;
+    return;
+  }
+
+  in_flight_ = size_;
+  current_ ^= 1U;
+  size_ = 0;
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,23 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <fcntl.h>
+
+namespace nutsloop::nlog {
+
+bool uring_sink::open(const std::filesystem::path &path, const bool truncate) {
+
+  close();
+  fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : O_APPEND),
+               0644);
+  if (fd_ < 0) {
+    set_error_("cannot open " + path.string());
+    return false;
+  }
+  return true;
+}
+
+} // namespace nutsloop::nlog
+
+#endif
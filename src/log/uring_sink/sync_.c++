@@ -0,0 +1,19 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void uring_sink::sync_() {
+  wait_();
+  const syscall_timer_t timer{*this};
+  if (fd_ >= 0 && ::fdatasync(fd_) != 0) {
+    set_error_("cannot sync");
+  }
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,24 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+namespace nutsloop::nlog {
+
+uring_sink::uring_sink(const sink_settings_t &settings)
+    : sink{settings.flush}, capacity_{settings.buffer_size},
+      buffers_{std::make_unique<char[]>(settings.buffer_size),
+               std::make_unique<char[]>(settings.buffer_size)} {
+  // HINT: a kernel without io_uring, or forbidding it, fails here.
+  supported_ = ::io_uring_queue_init(4, &ring_, 0) == 0;
+}
+
+uring_sink::~uring_sink() {
+  uring_sink::close();
+  if (supported_) {
+    ::io_uring_queue_exit(&ring_);
+  }
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,48 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <cerrno>
+
+namespace nutsloop::nlog {
+
+void uring_sink::wait_() {
+
+  if (in_flight_ == 0) {
+    return;
+  }
+
+  io_uring_cqe *completion = nullptr;
+  int result; // NOLINT(*-init-variables)
+  {
+    const syscall_timer_t timer{*this};
+    // HINT: an interrupted wait leaves the write pending, it is waited for
+    //  again, never written a second time.
+    do {
+      result = ::io_uring_wait_cqe(&ring_, &completion);
+    } while (result == -EINTR);
+  }
+
+  // no completion reaped, whether the kernel wrote the buffer is unknown.
+  if (result < 0) {
+    set_error_("cannot wait for the write in flight");
+    in_flight_ = 0;
+    return;
+  }
+
+  result = completion->res;
+  ::io_uring_cqe_seen(&ring_, completion);
+
+  // the buffer in flight is the one that is not current, whatever the
+  // kernel did not write is written synchronously.
+  const char *buffer = buffers_[current_ ^ 1U].get();
+  const std::size_t written = result > 0 ? static_cast<std::size_t>(result) : 0;
+  if (written < in_flight_) {
+    write_all_(buffer + written, in_flight_ - written);
+  }
+  in_flight_ = 0;
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,29 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <cstring>
+
+namespace nutsloop::nlog {
+
+void uring_sink::write_(const std::string_view data) {
+
+  if (size_ + data.size() > capacity_) {
+    flush_();
+  }
+
+  // a record larger than a buffer is written as it is, once everything
+  // before it has been.
+  if (data.size() > capacity_) {
+    wait_();
+    write_all_(data.data(), data.size());
+    return;
+  }
+
+  std::memcpy(buffers_[current_].get() + size_, data.data(), data.size());
+  size_ += data.size();
+}
+
+} // namespace nutsloop::nlog
+
+#endif
@@ -0,0 +1,31 @@
+#include "log/uring_sink.h++"
+
+#ifdef NLOG_HAVE_LIBURING
+
+#include <cerrno>
+
+#include <unistd.h>
+
+namespace nutsloop::nlog {
+
+void uring_sink::write_all_(const char *data, std::size_t size) {
+
+  const syscall_timer_t timer{*this};
+  while (size > 0) {
+    const ssize_t written = ::write(fd_, data, size);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // HINT: what is left of `data` is dropped, see `sink::write()`.
+      set_error_("cannot write");
+      return;
+    }
+    data += written;
+    size -= static_cast<std::size_t>(written);
+  }
+}
+
+} // namespace nutsloop::nlog
+
+#endif
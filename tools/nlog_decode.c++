@@ -0,0 +1,473 @@
+// nlog-decode, prints the records of binary logs (`encoding_t::BINARY`).
+//
+//   nlog-decode [--json] [--from TIME] [--to TIME] FILE...
+//
+// TIME is either seconds since the epoch or `YYYY-MM-DDTHH:MM:SS`, in UTC.
+// With `--from`, reading starts at the last SYNC frame older than TIME, found
+// by bisecting the file, so a slice of a large log costs about as much as the
+// slice itself. Records are printed one per line, as text or as JSON objects.
+
+#include "log/binary.h++"
+
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace nutsloop::nlog;
+
+namespace {
+
+// HINT: a record is written after it is made, it may follow a SYNC frame
+//  younger than itself by as long as it waited in the queue of the writer.
+constexpr std::uint64_t to_slack = 10'000'000'000;
+
+constexpr std::array<std::string_view, 6> level_names{"TRACE", "DEBUG", "INFO",
+                                                      "WARN",  "ERROR", ""};
+
+struct options_t {
+  bool json{false};
+  std::optional<std::uint64_t> from;
+  std::optional<std::uint64_t> to;
+  std::vector<std::string> files;
+};
+
+struct site_t {
+  std::uint8_t level;
+  std::uint32_t line;
+  std::string_view file;
+};
+
+struct sync_t {
+  std::size_t offset;
+  std::uint64_t time;
+};
+
+using value_t = std::variant<std::int64_t, std::uint64_t, double, bool, char, std::string_view>;
+
+/**
+ * A file mapped read only, for as long as the object lives.
+ */
+class mapping_t {
+public:
+  explicit mapping_t(const std::string &path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      return;
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) == 0 && status.st_size > 0) {
+      void *map = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ,
+                         MAP_PRIVATE, fd, 0);
+      if (map != MAP_FAILED) {
+        data_ = static_cast<const char *>(map);
+        size_ = static_cast<std::size_t>(status.st_size);
+      }
+    }
+    ::close(fd);
+  }
+  ~mapping_t() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char *>(data_), size_);
+    }
+  }
+
+  mapping_t(const mapping_t &) = delete;
+  mapping_t &operator=(const mapping_t &) = delete;
+
+  [[nodiscard]] const char *data() const { return data_; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+  const char *data_{nullptr};
+  std::size_t size_{0};
+};
+
+std::optional<std::uint64_t> parse_time(const std::string_view text) {
+
+  std::uint64_t seconds = 0;
+  if (const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), seconds);
+      error == std::errc{} && end == text.data() + text.size()) {
+    return seconds * 1'000'000'000;
+  }
+
+  int year = 0;
+  unsigned month = 0, day = 0, hours = 0, minutes = 0, secs = 0;
+  if (std::sscanf(std::string{text}.c_str(), "%d-%u-%uT%u:%u:%u", &year, &month, &day, &hours,
+                  &minutes, &secs) != 6) {
+    return std::nullopt;
+  }
+  const std::chrono::year_month_day date{std::chrono::year{year}, std::chrono::month{month},
+                                         std::chrono::day{day}};
+  if (!date.ok()) {
+    return std::nullopt;
+  }
+  const auto time = std::chrono::sys_days{date} + std::chrono::hours{hours} +
+                    std::chrono::minutes{minutes} + std::chrono::seconds{secs};
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+}
+
+/**
+ * The first SYNC frame starting at or after `offset`.
+ */
+std::optional<sync_t> next_sync(const mapping_t &file, std::size_t offset) {
+
+  while (offset < file.size()) {
+    const void *found = ::memmem(file.data() + offset, file.size() - offset,
+                                 binary::sync_marker.data(), binary::sync_marker.size());
+    if (found == nullptr) {
+      return std::nullopt;
+    }
+    const auto marker = static_cast<std::size_t>(static_cast<const char *>(found) - file.data());
+    offset = marker + 1;
+    // HINT: the marker could show up inside a record, the frame around it
+    //  must look like a SYNC frame too.
+    if (marker < binary::frame_header_size ||
+        marker - binary::frame_header_size + binary::sync_size > file.size()) {
+      continue;
+    }
+    const char *cursor = file.data() + marker - binary::frame_header_size;
+    if (binary::load<binary::frame_t>(cursor) != binary::frame_t::SYNC ||
+        binary::load<std::uint32_t>(cursor) != binary::sync_size - binary::frame_header_size) {
+      continue;
+    }
+    cursor += binary::sync_marker.size();
+    return sync_t{marker - binary::frame_header_size, binary::load<std::uint64_t>(cursor)};
+  }
+  return std::nullopt;
+}
+
+/**
+ * Where to start reading for records from `from` on: the last SYNC frame
+ * older than `from`, SYNC frames only grow older towards the beginning.
+ */
+std::size_t seek(const mapping_t &file, const std::uint64_t from) {
+
+  std::size_t start = binary::file_header_size;
+  std::size_t end = file.size();
+  while (end - start > binary::sync_interval) {
+    const std::size_t middle = start + (end - start) / 2;
+    const std::optional<sync_t> sync = next_sync(file, middle);
+    if (!sync.has_value() || sync->offset >= end || sync->time >= from) {
+      end = middle;
+    } else {
+      start = sync->offset;
+    }
+  }
+  return start;
+}
+
+template <typename T> T take(const char *&cursor, const char *end, bool &valid) {
+  if (static_cast<std::size_t>(end - cursor) < sizeof(T)) {
+    valid = false;
+    return T{};
+  }
+  return binary::load<T>(cursor);
+}
+
+std::vector<value_t> decode_fields(const char *cursor, const char *end) {
+
+  std::vector<value_t> values;
+  bool valid = true;
+  while (cursor < end && valid) {
+    switch (binary::load<binary::field_t>(cursor)) {
+    case binary::field_t::I64:
+      values.emplace_back(take<std::int64_t>(cursor, end, valid));
+      break;
+    case binary::field_t::U64:
+      values.emplace_back(take<std::uint64_t>(cursor, end, valid));
+      break;
+    case binary::field_t::F64:
+      values.emplace_back(take<double>(cursor, end, valid));
+      break;
+    case binary::field_t::BOOL:
+      values.emplace_back(take<bool>(cursor, end, valid));
+      break;
+    case binary::field_t::CHAR:
+      values.emplace_back(take<char>(cursor, end, valid));
+      break;
+    case binary::field_t::STRING: {
+      const auto size = take<std::uint32_t>(cursor, end, valid);
+      if (!valid || static_cast<std::size_t>(end - cursor) < size) {
+        valid = false;
+        break;
+      }
+      values.emplace_back(std::string_view{cursor, size});
+      cursor += size;
+      break;
+    }
+    default:
+      valid = false;
+    }
+  }
+  return values;
+}
+
+/**
+ * Formats `format` with `values`, one replacement field at a time, as
+ * `std::format` would have.
+ */
+std::string render(const std::string_view format, const std::vector<value_t> &values) {
+
+  std::string out;
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < format.size(); ++i) {
+    const char c = format[i];
+    if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+      out.push_back(c);
+      ++i;
+      continue;
+    }
+    if (c != '{') {
+      out.push_back(c);
+      continue;
+    }
+
+    const std::size_t close = format.find('}', i);
+    if (close == std::string_view::npos) {
+      out.append(format.substr(i));
+      break;
+    }
+    const std::string_view field = format.substr(i + 1, close - i - 1);
+    const std::size_t colon = field.find(':');
+    const std::string_view id = field.substr(0, colon);
+    std::size_t index = next++;
+    if (!id.empty()) {
+      std::from_chars(id.data(), id.data() + id.size(), index);
+    }
+    const std::string spec =
+        std::format("{{:{}}}", colon == std::string_view::npos ? "" : field.substr(colon + 1));
+
+    if (index < values.size()) {
+      try {
+        out.append(std::visit(
+            [&](const auto &value) { return std::vformat(spec, std::make_format_args(value)); },
+            values[index]));
+      } catch (const std::format_error &) {
+        out.append(format.substr(i, close - i + 1));
+      }
+    } else {
+      out.append(format.substr(i, close - i + 1));
+    }
+    i = close;
+  }
+  return out;
+}
+
+void append_json_string(std::string &out, const std::string_view text) {
+  out.push_back('"');
+  for (const char c : text) {
+    switch (c) {
+    case '"':
+      out.append("\\\"");
+      break;
+    case '\\':
+      out.append("\\\\");
+      break;
+    case '\n':
+      out.append("\\n");
+      break;
+    case '\r':
+      out.append("\\r");
+      break;
+    case '\t':
+      out.append("\\t");
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        out.append(std::format("\\u{:04x}", static_cast<unsigned>(c)));
+      } else {
+        out.push_back(c);
+      }
+    }
+  }
+  out.push_back('"');
+}
+
+void print(std::string &out, const options_t &options, const binary::record_header_t &header,
+           const site_t *site, const std::string_view message) {
+
+  const std::chrono::sys_time<std::chrono::nanoseconds> time{
+      std::chrono::nanoseconds{header.time}};
+  const std::string_view level =
+      header.level < level_names.size() ? level_names[header.level] : "UNKNOWN";
+
+  if (options.json) {
+    out.append(std::format(R"({{"time":"{:%FT%T}Z","thread":{},"level":)", time, header.thread));
+    append_json_string(out, level);
+    if (site != nullptr) {
+      out.append(R"(,"file":)");
+      append_json_string(out, site->file);
+      out.append(std::format(R"(,"line":{})", site->line));
+    }
+    out.append(R"(,"message":)");
+    append_json_string(out, message);
+    out.append("}\n");
+    return;
+  }
+
+  out.append(std::format("{:%FT%T}Z [{}]", time, header.thread));
+  if (!level.empty()) {
+    out.append(std::format(" [{}]", level));
+  }
+  if (site != nullptr) {
+    out.append(std::format(" [{}:{}]", site->file, site->line));
+  }
+  out.push_back(' ');
+  out.append(message);
+  out.push_back('\n');
+}
+
+bool decode(const std::string &path, const options_t &options) {
+
+  const mapping_t file{path};
+  if (file.data() == nullptr || file.size() < binary::file_header_size ||
+      std::memcmp(file.data(), binary::magic.data(), binary::magic.size()) != 0) {
+    std::fprintf(stderr, "nlog-decode: %s: not a binary log\n", path.c_str());
+    return false;
+  }
+  const char *version = file.data() + binary::magic.size();
+  if (binary::load<std::uint16_t>(version) != binary::version) {
+    std::fprintf(stderr, "nlog-decode: %s: unsupported version\n", path.c_str());
+    return false;
+  }
+
+  std::unordered_map<std::uint64_t, site_t> sites;
+  std::unordered_map<std::uint64_t, std::string_view> formats;
+  std::string out;
+
+  std::size_t offset = options.from.has_value() ? seek(file, *options.from)
+                                                : binary::file_header_size;
+  while (offset + binary::frame_header_size <= file.size()) {
+
+    const char *cursor = file.data() + offset;
+    const auto type = binary::load<binary::frame_t>(cursor);
+    const auto size = binary::load<std::uint32_t>(cursor);
+    // HINT: the zeroes ending a file the MMAP sink did not close, or a frame
+    //  cut short by a crash.
+    if (static_cast<std::uint8_t>(type) == 0 ||
+        file.size() - offset - binary::frame_header_size < size) {
+      break;
+    }
+    const char *end = cursor + size;
+
+    switch (type) {
+    case binary::frame_t::SYNC: {
+      cursor += binary::sync_marker.size();
+      const auto time = binary::load<std::uint64_t>(cursor);
+      if (options.to.has_value() && time > *options.to + to_slack) {
+        offset = file.size();
+        continue;
+      }
+      sites.clear();
+      formats.clear();
+      break;
+    }
+    case binary::frame_t::CALLSITE: {
+      const auto id = binary::load<std::uint64_t>(cursor);
+      const auto level = binary::load<std::uint8_t>(cursor);
+      const auto line = binary::load<std::uint32_t>(cursor);
+      sites[id] = site_t{level, line, std::string_view{cursor, end}};
+      break;
+    }
+    case binary::frame_t::FORMAT: {
+      const auto id = binary::load<std::uint64_t>(cursor);
+      formats[id] = std::string_view{cursor, end};
+      break;
+    }
+    case binary::frame_t::RECORD: {
+      const binary::record_header_t header = binary::load_record(file.data() + offset);
+      if ((options.from.has_value() && header.time < *options.from) ||
+          (options.to.has_value() && header.time > *options.to)) {
+        break;
+      }
+      const char *payload = file.data() + offset + binary::record_offset;
+      const auto site = sites.find(header.site);
+
+      std::string message;
+      if (header.format == 0) {
+        message.assign(payload, end);
+      } else if (const auto format = formats.find(header.format); format != formats.end()) {
+        message = render(format->second, decode_fields(payload, end));
+      }
+      if (message.ends_with('\n')) {
+        message.pop_back();
+      }
+      print(out, options, header, site != sites.end() ? &site->second : nullptr, message);
+      break;
+    }
+    default: {
+      // a damaged frame, reading goes on from the next SYNC frame.
+      const std::optional<sync_t> sync = next_sync(file, offset + 1);
+      offset = sync.has_value() ? sync->offset : file.size();
+      continue;
+    }
+    }
+
+    offset += binary::frame_header_size + size;
+    if (out.size() >= 64 * 1024) {
+      std::fwrite(out.data(), 1, out.size(), stdout);
+      out.clear();
+    }
+  }
+
+  std::fwrite(out.data(), 1, out.size(), stdout);
+  return true;
+}
+
+int usage() {
+  std::fputs("usage: nlog-decode [--json] [--from TIME] [--to TIME] FILE...\n"
+             "  TIME is seconds since the epoch or YYYY-MM-DDTHH:MM:SS, in UTC.\n",
+             stderr);
+  return 2;
+}
+
+} // namespace
+
+int main(const int argc, char **argv) {
+
+  options_t options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view argument = argv[i];
+    if (argument == "--json") {
+      options.json = true;
+    } else if (argument == "--from" || argument == "--to") {
+      if (i + 1 == argc) {
+        return usage();
+      }
+      const std::optional<std::uint64_t> time = parse_time(argv[++i]);
+      if (!time.has_value()) {
+        return usage();
+      }
+      (argument == "--from" ? options.from : options.to) = time;
+    } else if (argument.starts_with("--")) {
+      return usage();
+    } else {
+      options.files.emplace_back(argument);
+    }
+  }
+  if (options.files.empty()) {
+    return usage();
+  }
+
+  bool decoded = true;
+  for (const std::string &path : options.files) {
+    decoded = decode(path, options) && decoded;
+  }
+  return decoded ? 0 : 1;
+}